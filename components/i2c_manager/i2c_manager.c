@@ -0,0 +1,227 @@
+#include <string.h>
+#include <inttypes.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_log.h"
+#include "esp_heap_caps.h"
+
+#include "i2c_manager.h"
+
+#define TAG "I2C_MANAGER"
+
+struct i2c_manager_device {
+	uint16_t address;
+	uint32_t clk_hz; // 0 follows the bus clock
+	i2c_priority_t priority;
+	SemaphoreHandle_t lock; // One transaction of this device at a time
+	SemaphoreHandle_t granted; // Given when the bus is handed over to this device
+	struct i2c_manager_device * next; // Next in the list of devices waiting for the bus
+#if !I2C_MANAGER_LEGACY
+	i2c_master_dev_handle_t handle;
+#endif
+};
+
+static struct {
+	bool installed;
+	i2c_port_t port;
+	int sda;
+	int scl;
+	uint32_t clk_hz;
+	portMUX_TYPE spinlock; // Guards busy and waiting
+	bool busy;
+	i2c_manager_device_t waiting; // Highest priority first, first come first served within one
+#if !I2C_MANAGER_LEGACY
+	i2c_master_bus_handle_t bus;
+#endif
+} manager = {
+	.spinlock = portMUX_INITIALIZER_UNLOCKED,
+};
+
+// Take the bus for one transaction of device, waiting behind higher priority devices
+static void i2c_manager_acquire(i2c_manager_device_t device)
+{
+	xSemaphoreTake(device->lock, portMAX_DELAY);
+	portENTER_CRITICAL(&manager.spinlock);
+	if (!manager.busy) {
+		manager.busy = true;
+		portEXIT_CRITICAL(&manager.spinlock);
+		return;
+	}
+	i2c_manager_device_t * link = &manager.waiting;
+	while (*link != NULL && (*link)->priority >= device->priority) {
+		link = &(*link)->next;
+	}
+	device->next = *link;
+	*link = device;
+	portEXIT_CRITICAL(&manager.spinlock);
+	xSemaphoreTake(device->granted, portMAX_DELAY);
+}
+
+// Hand the bus to the first waiting device, or mark it free
+static void i2c_manager_release(i2c_manager_device_t device)
+{
+	portENTER_CRITICAL(&manager.spinlock);
+	i2c_manager_device_t next = manager.waiting;
+	if (next != NULL) {
+		manager.waiting = next->next;
+		next->next = NULL;
+	} else {
+		manager.busy = false;
+	}
+	portEXIT_CRITICAL(&manager.spinlock);
+	if (next != NULL) xSemaphoreGive(next->granted);
+	xSemaphoreGive(device->lock);
+}
+
+esp_err_t i2c_manager_init(i2c_port_t port, int sda, int scl, uint32_t clk_hz)
+{
+	if (manager.installed) return ESP_ERR_INVALID_STATE;
+	manager.port = port;
+	manager.sda = sda;
+	manager.scl = scl;
+	manager.clk_hz = clk_hz;
+
+	esp_err_t ret;
+#if I2C_MANAGER_LEGACY
+	ESP_LOGI(TAG, "Legacy i2c driver is used");
+	i2c_config_t i2c_config = {
+		.mode = I2C_MODE_MASTER,
+		.sda_io_num = sda,
+		.scl_io_num = scl,
+		.sda_pullup_en = GPIO_PULLUP_ENABLE,
+		.scl_pullup_en = GPIO_PULLUP_ENABLE,
+		.master.clk_speed = clk_hz
+	};
+	ret = i2c_param_config(port, &i2c_config);
+	if (ret == ESP_OK) ret = i2c_driver_install(port, I2C_MODE_MASTER, 0, 0, 0);
+#else
+	ESP_LOGI(TAG, "New i2c driver is used");
+	i2c_master_bus_config_t i2c_mst_config = {
+		.clk_source = I2C_CLK_SRC_DEFAULT,
+		.glitch_ignore_cnt = 7,
+		.i2c_port = port,
+		.scl_io_num = scl,
+		.sda_io_num = sda,
+		.flags.enable_internal_pullup = true,
+	};
+	ret = i2c_new_master_bus(&i2c_mst_config, &manager.bus);
+#endif
+	if (ret != ESP_OK) {
+		ESP_LOGE(TAG, "Could not install i2c port %d: %s", port, esp_err_to_name(ret));
+		return ret;
+	}
+	manager.installed = true;
+	ESP_LOGI(TAG, "i2c port %d at %"PRIu32" kHz", port, clk_hz / 1000);
+	return ESP_OK;
+}
+
+#if !I2C_MANAGER_LEGACY
+// The bus handle, for drivers that attach their devices themselves.
+// Their transactions are not arbitrated by the manager.
+i2c_master_bus_handle_t i2c_manager_get_bus(void)
+{
+	return manager.bus;
+}
+
+static esp_err_t i2c_manager_attach(i2c_manager_device_t device)
+{
+	i2c_device_config_t dev_cfg = {
+		.dev_addr_length = I2C_ADDR_BIT_LEN_7,
+		.device_address = device->address,
+		.scl_speed_hz = device->clk_hz ? device->clk_hz : manager.clk_hz,
+	};
+	return i2c_master_bus_add_device(manager.bus, &dev_cfg, &device->handle);
+}
+#endif
+
+// Attach a device at a 7 bit address. clk_hz 0 runs it at the bus clock.
+// With the legacy driver all devices share the bus clock.
+esp_err_t i2c_manager_add_device(uint16_t address, uint32_t clk_hz, i2c_priority_t priority, i2c_manager_device_t * device)
+{
+	if (!manager.installed) return ESP_ERR_INVALID_STATE;
+	i2c_manager_device_t _device = heap_caps_calloc(1, sizeof(struct i2c_manager_device), MALLOC_CAP_8BIT);
+	if (_device == NULL) return ESP_ERR_NO_MEM;
+	_device->address = address;
+	_device->clk_hz = clk_hz;
+	_device->priority = priority;
+	_device->lock = xSemaphoreCreateMutex();
+	_device->granted = xSemaphoreCreateBinary();
+	esp_err_t ret = ESP_OK;
+	if (_device->lock == NULL || _device->granted == NULL) ret = ESP_ERR_NO_MEM;
+#if !I2C_MANAGER_LEGACY
+	if (ret == ESP_OK) ret = i2c_manager_attach(_device);
+#endif
+	if (ret != ESP_OK) {
+		ESP_LOGE(TAG, "Could not add device 0x%02x: %s", address, esp_err_to_name(ret));
+		if (_device->lock != NULL) vSemaphoreDelete(_device->lock);
+		if (_device->granted != NULL) vSemaphoreDelete(_device->granted);
+		heap_caps_free(_device);
+		return ret;
+	}
+	*device = _device;
+	return ESP_OK;
+}
+
+// Change the SCL frequency of device. With the legacy driver this is the bus clock.
+esp_err_t i2c_manager_set_clock(i2c_manager_device_t device, uint32_t clk_hz)
+{
+	i2c_manager_acquire(device);
+	device->clk_hz = clk_hz;
+#if I2C_MANAGER_LEGACY
+	manager.clk_hz = clk_hz;
+	i2c_config_t i2c_config = {
+		.mode = I2C_MODE_MASTER,
+		.sda_io_num = manager.sda,
+		.scl_io_num = manager.scl,
+		.sda_pullup_en = GPIO_PULLUP_ENABLE,
+		.scl_pullup_en = GPIO_PULLUP_ENABLE,
+		.master.clk_speed = clk_hz
+	};
+	esp_err_t ret = i2c_param_config(manager.port, &i2c_config);
+#else
+	// The new driver fixes the speed when the device is added
+	esp_err_t ret = i2c_master_bus_rm_device(device->handle);
+	if (ret == ESP_OK) ret = i2c_manager_attach(device);
+#endif
+	i2c_manager_release(device);
+	return ret;
+}
+
+esp_err_t i2c_manager_write(i2c_manager_device_t device, const uint8_t * data, size_t len)
+{
+	i2c_manager_acquire(device);
+#if I2C_MANAGER_LEGACY
+	esp_err_t ret = i2c_master_write_to_device(manager.port, device->address, data, len, pdMS_TO_TICKS(I2C_MANAGER_TIMEOUT_MS));
+#else
+	esp_err_t ret = i2c_master_transmit(device->handle, data, len, I2C_MANAGER_TIMEOUT_MS);
+#endif
+	i2c_manager_release(device);
+	return ret;
+}
+
+esp_err_t i2c_manager_read(i2c_manager_device_t device, uint8_t * data, size_t len)
+{
+	i2c_manager_acquire(device);
+#if I2C_MANAGER_LEGACY
+	esp_err_t ret = i2c_master_read_from_device(manager.port, device->address, data, len, pdMS_TO_TICKS(I2C_MANAGER_TIMEOUT_MS));
+#else
+	esp_err_t ret = i2c_master_receive(device->handle, data, len, I2C_MANAGER_TIMEOUT_MS);
+#endif
+	i2c_manager_release(device);
+	return ret;
+}
+
+// Write out, then read in after a repeated start, e.g. a register read
+esp_err_t i2c_manager_write_read(i2c_manager_device_t device, const uint8_t * out, size_t out_len, uint8_t * in, size_t in_len)
+{
+	i2c_manager_acquire(device);
+#if I2C_MANAGER_LEGACY
+	esp_err_t ret = i2c_master_write_read_device(manager.port, device->address, out, out_len, in, in_len, pdMS_TO_TICKS(I2C_MANAGER_TIMEOUT_MS));
+#else
+	esp_err_t ret = i2c_master_transmit_receive(device->handle, out, out_len, in, in_len, I2C_MANAGER_TIMEOUT_MS);
+#endif
+	i2c_manager_release(device);
+	return ret;
+}
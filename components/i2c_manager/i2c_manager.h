@@ -0,0 +1,51 @@
+#ifndef I2C_MANAGER_H_
+#define I2C_MANAGER_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "esp_err.h"
+#include "esp_idf_version.h"
+#include "sdkconfig.h"
+
+// One I2C bus shared by several devices, e.g. the OLED and sensors.
+// The manager owns the port; devices attach with a priority and every transaction
+// is arbitrated: when the bus is released, the waiting device with the highest priority
+// gets it next. A display flush is split into short transactions, so a high priority
+// sensor read waits for at most one of them, never for a whole frame.
+//
+//	i2c_manager_init(I2C_NUM_0, sda, scl, 400000);
+//	i2c_manager_add_device(0x3C, 0, I2C_PRIORITY_LOW, &oled);
+//	i2c_manager_add_device(0x29, 400000, I2C_PRIORITY_HIGH, &tof);
+//	i2c_manager_write_read(tof, &reg, 1, range, 2);
+
+// Same driver selection as the ssd1306 component, the two drivers cannot be mixed
+#if CONFIG_LEGACY_DRIVER || (ESP_IDF_VERSION < ESP_IDF_VERSION_VAL(5, 2, 0))
+#define I2C_MANAGER_LEGACY 1
+#include "driver/i2c.h"
+#else
+#define I2C_MANAGER_LEGACY 0
+#include "driver/i2c_master.h"
+#endif
+
+#define I2C_MANAGER_TIMEOUT_MS 100 // Longest single transaction before it fails
+
+typedef enum {
+	I2C_PRIORITY_LOW,		// Bulk transfers such as display frames
+	I2C_PRIORITY_NORMAL,
+	I2C_PRIORITY_HIGH,		// Time critical reads
+} i2c_priority_t;
+
+typedef struct i2c_manager_device * i2c_manager_device_t;
+
+esp_err_t i2c_manager_init(i2c_port_t port, int sda, int scl, uint32_t clk_hz);
+#if !I2C_MANAGER_LEGACY
+i2c_master_bus_handle_t i2c_manager_get_bus(void);
+#endif
+esp_err_t i2c_manager_add_device(uint16_t address, uint32_t clk_hz, i2c_priority_t priority, i2c_manager_device_t * device);
+esp_err_t i2c_manager_set_clock(i2c_manager_device_t device, uint32_t clk_hz);
+esp_err_t i2c_manager_write(i2c_manager_device_t device, const uint8_t * data, size_t len);
+esp_err_t i2c_manager_read(i2c_manager_device_t device, uint8_t * data, size_t len);
+esp_err_t i2c_manager_write_read(i2c_manager_device_t device, const uint8_t * out, size_t out_len, uint8_t * in, size_t in_len);
+
+#endif /* I2C_MANAGER_H_ */
@@ -0,0 +1,240 @@
+/*
+ * font_prop16.c
+ *
+ * Generated by tools/fontconv.py from prop16.bdf. Do not edit.
+ * 16 pixels high, U+0020 - U+007E, 1320 bytes of glyph data.
+ * Sparse: U+00B0, U+00C5, U+00C6, U+00D8, U+00E5, U+00E6, U+00E9, U+00F8.
+ * Extra glyphs from prop16.bdf.
+ */
+
+#include "ssd1306_font.h"
+
+static const uint8_t font_prop16_bitmap[] = {
+	0xFE, 0x08,	// U+0021 !
+	0x1E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1E, 0x00,	// U+0022 "
+	0x00, 0x01, 0x10, 0x0D, 0xF0, 0x07, 0x3E, 0x01, 0x10, 0x0D, 0xF0, 0x07, 0x3E, 0x01, 0x10, 0x01,	// U+0023 #
+	0x18, 0x04, 0x3C, 0x0C, 0x62, 0x08, 0xFF, 0x3F, 0x42, 0x08, 0xC6, 0x06, 0x80, 0x03,	// U+0024 $
+	0x3E, 0x00, 0x22, 0x0C, 0x22, 0x06, 0x9C, 0x01, 0xC0, 0x00, 0x60, 0x02, 0x98, 0x0F, 0x8C, 0x08, 0x82, 0x08, 0x00, 0x07,	// U+0025 %
+	0x80, 0x07, 0x5C, 0x0C, 0x76, 0x08, 0x42, 0x08, 0x82, 0x09, 0x06, 0x07, 0x04, 0x07, 0xC0, 0x0D, 0x00, 0x08,	// U+0026 &
+	0x1E, 0x00,	// U+0027 '
+	0xF0, 0x07, 0x1E, 0x1C, 0x02, 0x20,	// U+0028 (
+	0x06, 0x38, 0xFC, 0x0F,	// U+0029 )
+	0x14, 0x00, 0x1C, 0x00, 0x1C, 0x00, 0x14, 0x00,	// U+002A *
+	0x80, 0x00, 0x80, 0x00, 0x80, 0x00, 0xF8, 0x07, 0x80, 0x00, 0x80, 0x00, 0x80, 0x00,	// U+002B +
+	0x00, 0x38,	// U+002C ,
+	0x80, 0x00, 0x80, 0x00, 0x80, 0x00, 0x80, 0x00,	// U+002D -
+	0x00, 0x08,	// U+002E .
+	0x00, 0x18, 0x00, 0x0E, 0xC0, 0x01, 0x70, 0x00, 0x0E, 0x00, 0x02, 0x00,	// U+002F /
+	0xE0, 0x00, 0xFC, 0x07, 0x06, 0x0C, 0x02, 0x08, 0x02, 0x08, 0x02, 0x08, 0x0C, 0x06, 0xF8, 0x03,	// U+0030 0
+	0x18, 0x08, 0x0C, 0x08, 0xFE, 0x0F, 0xFE, 0x0F, 0x00, 0x08, 0x00, 0x08,	// U+0031 1
+	0x08, 0x0C, 0x0C, 0x0E, 0x02, 0x0B, 0x82, 0x09, 0xC2, 0x08, 0x7C, 0x08, 0x18, 0x08,	// U+0032 2
+	0x08, 0x06, 0x0C, 0x0C, 0x02, 0x08, 0x42, 0x08, 0x42, 0x08, 0xFE, 0x06, 0x98, 0x07,	// U+0033 3
+	0x00, 0x01, 0xC0, 0x01, 0x60, 0x01, 0x30, 0x01, 0x0C, 0x01, 0x0E, 0x01, 0xFE, 0x0F, 0x00, 0x01,	// U+0034 4
+	0x20, 0x0C, 0x3E, 0x08, 0x22, 0x08, 0x22, 0x08, 0x62, 0x0C, 0xC2, 0x07, 0x80, 0x03,	// U+0035 5
+	0xC0, 0x07, 0x70, 0x0C, 0x38, 0x08, 0x2C, 0x08, 0x26, 0x08, 0xE0, 0x06, 0xC0, 0x03,	// U+0036 6
+	0x02, 0x00, 0x02, 0x0C, 0x02, 0x0F, 0xC2, 0x03, 0xF2, 0x00, 0x1E, 0x00, 0x06, 0x00,	// U+0037 7
+	0x9C, 0x07, 0xFE, 0x0C, 0x42, 0x08, 0x42, 0x08, 0x42, 0x08, 0xBC, 0x0F, 0x18, 0x07,	// U+0038 8
+	0x38, 0x00, 0x7C, 0x00, 0x42, 0x0C, 0x42, 0x06, 0xC2, 0x03, 0xE6, 0x00, 0x7C, 0x00,	// U+0039 9
+	0x10, 0x08, 0x10, 0x08,	// U+003A :
+	0x10, 0x28, 0x10, 0x18,	// U+003B ;
+	0x40, 0x00, 0xC0, 0x00, 0xE0, 0x01, 0x20, 0x01, 0x30, 0x03, 0x10, 0x02,	// U+003C <
+	0x20, 0x01, 0x20, 0x01, 0x20, 0x01, 0x20, 0x01, 0x20, 0x01, 0x20, 0x01, 0x20, 0x01,	// U+003D =
+	0x10, 0x02, 0x30, 0x01, 0x20, 0x01, 0xC0, 0x00, 0xC0, 0x00,	// U+003E >
+	0x06, 0x00, 0xC2, 0x09, 0x62, 0x00, 0x3E, 0x00, 0x18, 0x00,	// U+003F ?
+	0xE0, 0x07, 0x10, 0x18, 0x08, 0x10, 0xCC, 0x37, 0x64, 0x24, 0x24, 0x26, 0xA4, 0x23, 0x64, 0x24, 0x08, 0x34, 0x30, 0x13, 0xE0, 0x01,	// U+0040 @
+	0x00, 0x08, 0x00, 0x0F, 0xC0, 0x03, 0x78, 0x01, 0x1E, 0x01, 0x0E, 0x01, 0x78, 0x01, 0xE0, 0x01, 0x00, 0x0F, 0x00, 0x0C,	// U+0041 A
+	0xFE, 0x0F, 0xFE, 0x0F, 0x42, 0x08, 0x42, 0x08, 0x42, 0x08, 0x66, 0x08, 0xBC, 0x07, 0x08, 0x03,	// U+0042 B
+	0xF8, 0x03, 0x1C, 0x07, 0x04, 0x0C, 0x02, 0x08, 0x02, 0x08, 0x02, 0x08, 0x02, 0x08, 0x06, 0x04,	// U+0043 C
+	0xFE, 0x0F, 0xFE, 0x0F, 0x02, 0x08, 0x02, 0x08, 0x02, 0x08, 0x02, 0x08, 0x06, 0x0C, 0x0C, 0x06, 0xF8, 0x03, 0xE0, 0x00,	// U+0044 D
+	0xFE, 0x0F, 0xFE, 0x0F, 0x42, 0x08, 0x42, 0x08, 0x42, 0x08, 0x42, 0x08, 0x02, 0x08,	// U+0045 E
+	0xFE, 0x0F, 0xFE, 0x0F, 0x42, 0x00, 0x42, 0x00, 0x42, 0x00, 0x42, 0x00, 0x02, 0x00,	// U+0046 F
+	0xF8, 0x03, 0x1C, 0x07, 0x04, 0x04, 0x02, 0x08, 0x02, 0x08, 0x02, 0x08, 0x82, 0x08, 0x86, 0x0C, 0x84, 0x07,	// U+0047 G
+	0xFE, 0x0F, 0xFE, 0x0F, 0x40, 0x00, 0x40, 0x00, 0x40, 0x00, 0x40, 0x00, 0x40, 0x00, 0xFE, 0x0F, 0xFE, 0x0F,	// U+0048 H
+	0xFE, 0x0F,	// U+0049 I
+	0x00, 0x08, 0x00, 0x08, 0x00, 0x0C, 0xFE, 0x07,	// U+004A J
+	0xFE, 0x0F, 0xFE, 0x0F, 0x40, 0x00, 0xE0, 0x00, 0xF0, 0x01, 0x18, 0x03, 0x0C, 0x06, 0x06, 0x0C, 0x00, 0x08,	// U+004B K
+	0xFE, 0x0F, 0xFE, 0x0F, 0x00, 0x08, 0x00, 0x08, 0x00, 0x08, 0x00, 0x08,	// U+004C L
+	0xFE, 0x0F, 0xFE, 0x0F, 0x1C, 0x00, 0x70, 0x00, 0xC0, 0x01, 0x00, 0x03, 0x80, 0x03, 0xC0, 0x01, 0x70, 0x00, 0x1C, 0x00, 0xFE, 0x0F, 0xFE, 0x0F,	// U+004D M
+	0xFE, 0x0F, 0xFE, 0x0F, 0x1C, 0x00, 0x30, 0x00, 0xE0, 0x00, 0xC0, 0x01, 0x00, 0x03, 0x00, 0x06, 0xFE, 0x0F,	// U+004E N
+	0xF8, 0x03, 0x1C, 0x07, 0x04, 0x0C, 0x02, 0x08, 0x02, 0x08, 0x02, 0x08, 0x02, 0x08, 0x04, 0x04, 0x1C, 0x07, 0xF8, 0x03,	// U+004F O
+	0xFE, 0x0F, 0xFE, 0x0F, 0x82, 0x00, 0x82, 0x00, 0x82, 0x00, 0xC6, 0x00, 0x7C, 0x00, 0x38, 0x00,	// U+0050 P
+	0xF8, 0x03, 0x1C, 0x07, 0x04, 0x0C, 0x02, 0x08, 0x02, 0x08, 0x02, 0x08, 0x02, 0x08, 0x04, 0x1C, 0x1C, 0x37, 0xF8, 0x63,	// U+0051 Q
+	0xFE, 0x0F, 0xFE, 0x0F, 0x42, 0x00, 0x42, 0x00, 0xC2, 0x01, 0x66, 0x03, 0x3C, 0x0E, 0x00, 0x08,	// U+0052 R
+	0x3C, 0x0C, 0x76, 0x08, 0x62, 0x08, 0x42, 0x08, 0xC2, 0x0C, 0x84, 0x07,	// U+0053 S
+	0x02, 0x00, 0x02, 0x00, 0x02, 0x00, 0x02, 0x00, 0xFE, 0x0F, 0x02, 0x00, 0x02, 0x00, 0x02, 0x00, 0x02, 0x00,	// U+0054 T
+	0xFE, 0x01, 0xFE, 0x07, 0x00, 0x0C, 0x00, 0x08, 0x00, 0x08, 0x00, 0x08, 0x00, 0x0C, 0xFE, 0x07, 0xFE, 0x01,	// U+0055 U
+	0x02, 0x00, 0x1E, 0x00, 0x78, 0x00, 0xC0, 0x03, 0x00, 0x0F, 0x00, 0x0E, 0xC0, 0x03, 0xF0, 0x00, 0x1E, 0x00, 0x06, 0x00,	// U+0056 V
+	0x06, 0x00, 0x3E, 0x00, 0xF8, 0x01, 0x80, 0x0F, 0x00, 0x0E, 0xC0, 0x03, 0x78, 0x00, 0x0E, 0x00, 0x3C, 0x00, 0xE0, 0x01, 0x00, 0x0F, 0x00, 0x0F, 0xE0, 0x03, 0x7E, 0x00, 0x06, 0x00,	// U+0057 W
+	0x00, 0x08, 0x06, 0x0C, 0x1C, 0x07, 0xB8, 0x01, 0xE0, 0x00, 0xF0, 0x00, 0x98, 0x03, 0x0E, 0x0E, 0x02, 0x0C,	// U+0058 X
+	0x02, 0x00, 0x0E, 0x00, 0x1C, 0x00, 0x70, 0x00, 0xC0, 0x0F, 0xE0, 0x0F, 0x38, 0x00, 0x0E, 0x00, 0x06, 0x00,	// U+0059 Y
+	0x02, 0x0C, 0x02, 0x0F, 0x82, 0x0B, 0xE2, 0x08, 0x72, 0x08, 0x1E, 0x08, 0x0E, 0x08, 0x02, 0x08,	// U+005A Z
+	0xFF, 0x3F, 0x01, 0x20, 0x01, 0x20,	// U+005B [
+	0x06, 0x00, 0x1C, 0x00, 0xE0, 0x00, 0x80, 0x07, 0x00, 0x1C,	// U+005C 
+	0x01, 0x20, 0xFF, 0x3F, 0xFF, 0x3F,	// U+005D ]
+	0x20, 0x00, 0x38, 0x00, 0x0C, 0x00, 0x06, 0x00, 0x1C, 0x00, 0x30, 0x00,	// U+005E ^
+	0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20,	// U+005F _
+	0x02, 0x00, 0x04, 0x00,	// U+0060 `
+	0x20, 0x0E, 0x30, 0x0B, 0x10, 0x09, 0x10, 0x09, 0xF0, 0x07, 0xC0, 0x0F,	// U+0061 a
+	0xFE, 0x0F, 0xFE, 0x0F, 0x10, 0x08, 0x10, 0x08, 0x10, 0x0C, 0xF0, 0x07, 0xC0, 0x03,	// U+0062 b
+	0xE0, 0x07, 0x30, 0x0C, 0x10, 0x08, 0x10, 0x08, 0x10, 0x08,	// U+0063 c
+	0xE0, 0x07, 0x30, 0x0C, 0x10, 0x08, 0x10, 0x08, 0x30, 0x04, 0xFE, 0x0F,	// U+0064 d
+	0xE0, 0x07, 0xB0, 0x0C, 0x90, 0x08, 0x90, 0x08, 0xB0, 0x08, 0xE0, 0x04,	// U+0065 e
+	0x10, 0x00, 0xF8, 0x0F, 0xFE, 0x0F, 0x12, 0x00, 0x12, 0x00,	// U+0066 f
+	0x00, 0x20, 0xE0, 0x7E, 0xB0, 0x4D, 0x10, 0x49, 0x10, 0x49, 0xF0, 0x68, 0x70, 0x38,	// U+0067 g
+	0xFE, 0x0F, 0xFE, 0x0F, 0x10, 0x00, 0x10, 0x00, 0x10, 0x00, 0xE0, 0x0F,	// U+0068 h
+	0xF2, 0x0F, 0xF2, 0x0F,	// U+0069 i
+	0x00, 0x40, 0xF2, 0x7F, 0xF2, 0x3F,	// U+006A j
+	0xFE, 0x0F, 0xFE, 0x0F, 0xC0, 0x01, 0xE0, 0x03, 0x30, 0x06, 0x10, 0x0C,	// U+006B k
+	0xFE, 0x0F, 0xFE, 0x0F,	// U+006C l
+	0xF0, 0x0F, 0xE0, 0x0F, 0x10, 0x00, 0x10, 0x00, 0xF0, 0x0F, 0xE0, 0x0F, 0x30, 0x00, 0x10, 0x00, 0x10, 0x00, 0xE0, 0x0F,	// U+006D m
+	0xF0, 0x0F, 0xE0, 0x0F, 0x10, 0x00, 0x10, 0x00, 0x10, 0x00, 0xE0, 0x0F,	// U+006E n
+	0xE0, 0x07, 0x30, 0x0C, 0x10, 0x08, 0x10, 0x08, 0x30, 0x0C, 0xE0, 0x07, 0xC0, 0x03,	// U+006F o
+	0xF0, 0x7F, 0xE0, 0x7F, 0x10, 0x08, 0x10, 0x08, 0x10, 0x0C, 0xE0, 0x07, 0xC0, 0x03,	// U+0070 p
+	0xE0, 0x07, 0x30, 0x0C, 0x10, 0x08, 0x10, 0x08, 0x20, 0x04, 0xF0, 0x7F,	// U+0071 q
+	0xF0, 0x0F, 0xE0, 0x0F, 0x10, 0x00, 0x10, 0x00, 0x10, 0x00,	// U+0072 r
+	0xE0, 0x0C, 0x90, 0x08, 0x90, 0x09, 0x10, 0x0F, 0x00, 0x07,	// U+0073 s
+	0x10, 0x00, 0xF0, 0x03, 0xFC, 0x0F, 0x10, 0x08, 0x10, 0x08,	// U+0074 t
+	0xF0, 0x07, 0x00, 0x0C, 0x00, 0x08, 0x00, 0x08, 0x00, 0x04, 0xF0, 0x0F,	// U+0075 u
+	0x10, 0x00, 0xF0, 0x00, 0xC0, 0x03, 0x00, 0x0E, 0x00, 0x0F, 0xC0, 0x01, 0x70, 0x00,	// U+0076 v
+	0x30, 0x00, 0xF0, 0x01, 0x80, 0x0F, 0x00, 0x0E, 0xC0, 0x03, 0x70, 0x00, 0xF0, 0x00, 0x00, 0x0F, 0x00, 0x0E, 0xC0, 0x03, 0x70, 0x00,	// U+0077 w
+	0x00, 0x08, 0x30, 0x0C, 0x60, 0x07, 0x80, 0x01, 0xC0, 0x03, 0x70, 0x0E, 0x10, 0x08,	// U+0078 x
+	0x10, 0x00, 0xF0, 0x00, 0xC0, 0x63, 0x00, 0x3E, 0x00, 0x0F, 0xC0, 0x01, 0x70, 0x00,	// U+0079 y
+	0x00, 0x08, 0x10, 0x0C, 0x10, 0x0F, 0x90, 0x09, 0xF0, 0x08, 0x30, 0x08,	// U+007A z
+	0x40, 0x00, 0xFE, 0x1F, 0x13, 0x31, 0x01, 0x20,	// U+007B {
+	0xFF, 0x7F,	// U+007C |
+	0x01, 0x20, 0xBF, 0x3F, 0x44, 0x0C,	// U+007D }
+	0x80, 0x01, 0x40, 0x00, 0x40, 0x00, 0xC0, 0x00, 0x80, 0x00, 0xC0, 0x00, 0x40, 0x00,	// U+007E ~
+	0x3C, 0x00, 0x22, 0x00, 0x22, 0x00, 0x1C, 0x00,	// U+00B0 °
+	0x00, 0x08, 0x00, 0x0F, 0xC0, 0x03, 0x78, 0x01, 0x1F, 0x01, 0x0F, 0x01, 0x78, 0x01, 0xE0, 0x01, 0x00, 0x0F, 0x00, 0x0C,	// U+00C5 Å
+	0x00, 0x08, 0x00, 0x0E, 0x80, 0x03, 0xE0, 0x01, 0x38, 0x01, 0x0E, 0x01, 0x3E, 0x01, 0xFE, 0x0F, 0x42, 0x0C, 0x42, 0x08, 0x42, 0x08, 0x42, 0x08, 0x02, 0x08,	// U+00C6 Æ
+	0xF8, 0x03, 0x1C, 0x0F, 0x04, 0x0E, 0x02, 0x0B, 0x82, 0x08, 0x62, 0x08, 0x12, 0x08, 0x0E, 0x04, 0x1E, 0x07, 0xFA, 0x03,	// U+00D8 Ø
+	0x20, 0x0E, 0x34, 0x0B, 0x1A, 0x09, 0x1E, 0x09, 0xF0, 0x07, 0xC0, 0x0F,	// U+00E5 å
+	0x20, 0x0F, 0x90, 0x09, 0x90, 0x08, 0x90, 0x08, 0xF0, 0x07, 0xE0, 0x07, 0x90, 0x0C, 0x90, 0x08, 0x90, 0x08, 0xE0, 0x0C, 0xC0, 0x00,	// U+00E6 æ
+	0xE0, 0x07, 0xB0, 0x0C, 0x90, 0x08, 0x96, 0x08, 0xB2, 0x08, 0xE0, 0x04,	// U+00E9 é
+	0xE0, 0x0F, 0x30, 0x0E, 0x10, 0x0B, 0x90, 0x08, 0x70, 0x0C, 0xF0, 0x07, 0xC0, 0x03,	// U+00F8 ø
+};
+
+static const ssd1306_glyph_t font_prop16_glyphs[] = {
+	{     0,  0,  0,  3 },	// U+0020
+	{     0,  1,  2,  5 },	// U+0021
+	{     2,  4,  1,  6 },	// U+0022
+	{    10,  8,  0,  9 },	// U+0023
+	{    26,  7,  1,  9 },	// U+0024
+	{    40, 10,  1, 12 },	// U+0025
+	{    60,  9,  1, 11 },	// U+0026
+	{    78,  1,  1,  3 },	// U+0027
+	{    80,  3,  1,  5 },	// U+0028
+	{    86,  2,  1,  5 },	// U+0029
+	{    90,  4,  1,  6 },	// U+002A
+	{    98,  7,  1,  9 },	// U+002B
+	{   112,  1,  1,  3 },	// U+002C
+	{   114,  4,  1,  5 },	// U+002D
+	{   122,  1,  1,  3 },	// U+002E
+	{   124,  6,  0,  6 },	// U+002F
+	{   136,  8,  0,  9 },	// U+0030
+	{   152,  6,  2,  9 },	// U+0031
+	{   164,  7,  1,  9 },	// U+0032
+	{   178,  7,  1,  9 },	// U+0033
+	{   192,  8,  0,  9 },	// U+0034
+	{   208,  7,  1,  9 },	// U+0035
+	{   222,  7,  1,  9 },	// U+0036
+	{   236,  7,  1,  9 },	// U+0037
+	{   250,  7,  1,  9 },	// U+0038
+	{   264,  7,  1,  9 },	// U+0039
+	{   278,  2,  1,  4 },	// U+003A
+	{   282,  2,  1,  4 },	// U+003B
+	{   286,  6,  1,  9 },	// U+003C
+	{   298,  7,  1,  9 },	// U+003D
+	{   312,  5,  2,  9 },	// U+003E
+	{   322,  5,  1,  6 },	// U+003F
+	{   332, 11,  1, 12 },	// U+0040
+	{   354, 10,  0, 10 },	// U+0041
+	{   374,  8,  1, 10 },	// U+0042
+	{   390,  8,  1, 10 },	// U+0043
+	{   406, 10,  1, 11 },	// U+0044
+	{   426,  7,  1,  9 },	// U+0045
+	{   440,  7,  1,  8 },	// U+0046
+	{   454,  9,  1, 11 },	// U+0047
+	{   472,  9,  1, 11 },	// U+0048
+	{   490,  1,  2,  5 },	// U+0049
+	{   492,  4,  1,  7 },	// U+004A
+	{   500,  9,  1, 10 },	// U+004B
+	{   518,  6,  1,  8 },	// U+004C
+	{   530, 12,  1, 14 },	// U+004D
+	{   554,  9,  1, 11 },	// U+004E
+	{   572, 10,  1, 12 },	// U+004F
+	{   592,  8,  1,  9 },	// U+0050
+	{   608, 10,  1, 12 },	// U+0051
+	{   628,  8,  1, 10 },	// U+0052
+	{   644,  6,  1,  8 },	// U+0053
+	{   656,  9,  0,  9 },	// U+0054
+	{   674,  9,  1, 11 },	// U+0055
+	{   692, 10,  0, 10 },	// U+0056
+	{   712, 15,  0, 15 },	// U+0057
+	{   742,  9,  0, 10 },	// U+0058
+	{   760,  9,  0,  9 },	// U+0059
+	{   778,  8,  1,  9 },	// U+005A
+	{   794,  3,  1,  5 },	// U+005B
+	{   800,  5,  0,  6 },	// U+005C
+	{   810,  3,  1,  5 },	// U+005D
+	{   816,  6,  1,  9 },	// U+005E
+	{   828,  6,  0,  6 },	// U+005F
+	{   840,  2,  1,  5 },	// U+0060
+	{   844,  6,  1,  8 },	// U+0061
+	{   856,  7,  1,  8 },	// U+0062
+	{   870,  5,  1,  7 },	// U+0063
+	{   880,  6,  1,  8 },	// U+0064
+	{   892,  6,  1,  8 },	// U+0065
+	{   904,  5,  0,  5 },	// U+0066
+	{   914,  7,  0,  8 },	// U+0067
+	{   928,  6,  1,  8 },	// U+0068
+	{   940,  2,  1,  4 },	// U+0069
+	{   944,  3,  0,  4 },	// U+006A
+	{   950,  6,  1,  8 },	// U+006B
+	{   962,  2,  1,  4 },	// U+006C
+	{   966, 10,  1, 12 },	// U+006D
+	{   986,  6,  1,  8 },	// U+006E
+	{   998,  7,  1,  8 },	// U+006F
+	{  1012,  7,  1,  8 },	// U+0070
+	{  1026,  6,  1,  8 },	// U+0071
+	{  1038,  5,  1,  6 },	// U+0072
+	{  1048,  5,  1,  7 },	// U+0073
+	{  1058,  5,  0,  6 },	// U+0074
+	{  1068,  6,  1,  8 },	// U+0075
+	{  1080,  7,  0,  8 },	// U+0076
+	{  1094, 11,  0, 11 },	// U+0077
+	{  1116,  7,  0,  8 },	// U+0078
+	{  1130,  7,  0,  8 },	// U+0079
+	{  1144,  6,  0,  7 },	// U+007A
+	{  1156,  4,  0,  5 },	// U+007B
+	{  1164,  1,  2,  5 },	// U+007C
+	{  1166,  3,  1,  5 },	// U+007D
+	{  1172,  7,  1,  9 },	// U+007E
+	{  1186,  4,  1,  6 },	// U+00B0
+	{  1194, 10,  0, 10 },	// U+00C5
+	{  1214, 13,  0, 14 },	// U+00C6
+	{  1240, 10,  1, 12 },	// U+00D8
+	{  1260,  6,  1,  8 },	// U+00E5
+	{  1272, 11,  1, 12 },	// U+00E6
+	{  1294,  6,  1,  8 },	// U+00E9
+	{  1306,  7,  1,  8 },	// U+00F8
+};
+
+static const uint8_t font_prop16_ext_index[] = {
+	 95,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,	// U+00B0
+	  0,   0,   0,   0,   0,  96,  97,   0,   0,   0,   0,   0,   0,   0,   0,   0,	// U+00C0
+	  0,   0,   0,   0,   0,   0,   0,   0,  98,   0,   0,   0,   0,   0,   0,   0,	// U+00D0
+	  0,   0,   0,   0,   0,  99, 100,   0,   0, 101,   0,   0,   0,   0,   0,   0,	// U+00E0
+	  0,   0,   0,   0,   0,   0,   0,   0, 102,	// U+00F0
+};
+
+const ssd1306_font_t font_prop16 = {
+	.height = 16,
+	.first = 0x0020,
+	.last = 0x007E,
+	.glyphs = font_prop16_glyphs,
+	.bitmap = font_prop16_bitmap,
+	.ext_first = 0x00B0,
+	.ext_last = 0x00F8,
+	.ext_index = font_prop16_ext_index,
+};
@@ -0,0 +1,240 @@
+/*
+ * font_prop8.c
+ *
+ * Generated by tools/fontconv.py from font8x8_basic.h. Do not edit.
+ * 8 pixels high, U+0020 - U+007E, 615 bytes of glyph data.
+ * Sparse: U+00B0, U+00C5, U+00C6, U+00D8, U+00E5, U+00E6, U+00E9, U+00F8.
+ * Extra glyphs from font8x8_latin1.bdf.
+ */
+
+#include "ssd1306_font.h"
+
+static const uint8_t font_prop8_bitmap[] = {
+	0x06, 0x5F, 0x5F, 0x06,	// U+0021 !
+	0x03, 0x03, 0x00, 0x03, 0x03,	// U+0022 "
+	0x14, 0x7F, 0x7F, 0x14, 0x7F, 0x7F, 0x14,	// U+0023 #
+	0x24, 0x2E, 0x6B, 0x6B, 0x3A, 0x12,	// U+0024 $
+	0x46, 0x66, 0x30, 0x18, 0x0C, 0x66, 0x62,	// U+0025 %
+	0x30, 0x7A, 0x4F, 0x5D, 0x37, 0x7A, 0x48,	// U+0026 &
+	0x04, 0x07, 0x03,	// U+0027 '
+	0x1C, 0x3E, 0x63, 0x41,	// U+0028 (
+	0x41, 0x63, 0x3E, 0x1C,	// U+0029 )
+	0x08, 0x2A, 0x3E, 0x1C, 0x1C, 0x3E, 0x2A, 0x08,	// U+002A *
+	0x08, 0x08, 0x3E, 0x3E, 0x08, 0x08,	// U+002B +
+	0x80, 0xE0, 0x60,	// U+002C ,
+	0x08, 0x08, 0x08, 0x08, 0x08, 0x08,	// U+002D -
+	0x60, 0x60,	// U+002E .
+	0x60, 0x30, 0x18, 0x0C, 0x06, 0x03, 0x01,	// U+002F /
+	0x3E, 0x7F, 0x71, 0x59, 0x4D, 0x7F, 0x3E,	// U+0030 0
+	0x40, 0x42, 0x7F, 0x7F, 0x40, 0x40,	// U+0031 1
+	0x62, 0x73, 0x59, 0x49, 0x6F, 0x66,	// U+0032 2
+	0x22, 0x63, 0x49, 0x49, 0x7F, 0x36,	// U+0033 3
+	0x18, 0x1C, 0x16, 0x53, 0x7F, 0x7F, 0x50,	// U+0034 4
+	0x27, 0x67, 0x45, 0x45, 0x7D, 0x39,	// U+0035 5
+	0x3C, 0x7E, 0x4B, 0x49, 0x79, 0x30,	// U+0036 6
+	0x03, 0x03, 0x71, 0x79, 0x0F, 0x07,	// U+0037 7
+	0x36, 0x7F, 0x49, 0x49, 0x7F, 0x36,	// U+0038 8
+	0x06, 0x4F, 0x49, 0x69, 0x3F, 0x1E,	// U+0039 9
+	0x66, 0x66,	// U+003A :
+	0x80, 0xE6, 0x66,	// U+003B ;
+	0x08, 0x1C, 0x36, 0x63, 0x41,	// U+003C <
+	0x24, 0x24, 0x24, 0x24, 0x24, 0x24,	// U+003D =
+	0x41, 0x63, 0x36, 0x1C, 0x08,	// U+003E >
+	0x02, 0x03, 0x51, 0x59, 0x0F, 0x06,	// U+003F ?
+	0x3E, 0x7F, 0x41, 0x5D, 0x5D, 0x1F, 0x1E,	// U+0040 @
+	0x7C, 0x7E, 0x13, 0x13, 0x7E, 0x7C,	// U+0041 A
+	0x41, 0x7F, 0x7F, 0x49, 0x49, 0x7F, 0x36,	// U+0042 B
+	0x1C, 0x3E, 0x63, 0x41, 0x41, 0x63, 0x22,	// U+0043 C
+	0x41, 0x7F, 0x7F, 0x41, 0x63, 0x3E, 0x1C,	// U+0044 D
+	0x41, 0x7F, 0x7F, 0x49, 0x5D, 0x41, 0x63,	// U+0045 E
+	0x41, 0x7F, 0x7F, 0x49, 0x1D, 0x01, 0x03,	// U+0046 F
+	0x1C, 0x3E, 0x63, 0x41, 0x51, 0x73, 0x72,	// U+0047 G
+	0x7F, 0x7F, 0x08, 0x08, 0x7F, 0x7F,	// U+0048 H
+	0x41, 0x7F, 0x7F, 0x41,	// U+0049 I
+	0x30, 0x70, 0x40, 0x41, 0x7F, 0x3F, 0x01,	// U+004A J
+	0x41, 0x7F, 0x7F, 0x08, 0x1C, 0x77, 0x63,	// U+004B K
+	0x41, 0x7F, 0x7F, 0x41, 0x40, 0x60, 0x70,	// U+004C L
+	0x7F, 0x7F, 0x0E, 0x1C, 0x0E, 0x7F, 0x7F,	// U+004D M
+	0x7F, 0x7F, 0x06, 0x0C, 0x18, 0x7F, 0x7F,	// U+004E N
+	0x1C, 0x3E, 0x63, 0x41, 0x63, 0x3E, 0x1C,	// U+004F O
+	0x41, 0x7F, 0x7F, 0x49, 0x09, 0x0F, 0x06,	// U+0050 P
+	0x1E, 0x3F, 0x21, 0x71, 0x7F, 0x5E,	// U+0051 Q
+	0x41, 0x7F, 0x7F, 0x09, 0x19, 0x7F, 0x66,	// U+0052 R
+	0x26, 0x6F, 0x4D, 0x59, 0x73, 0x32,	// U+0053 S
+	0x03, 0x41, 0x7F, 0x7F, 0x41, 0x03,	// U+0054 T
+	0x7F, 0x7F, 0x40, 0x40, 0x7F, 0x7F,	// U+0055 U
+	0x1F, 0x3F, 0x60, 0x60, 0x3F, 0x1F,	// U+0056 V
+	0x7F, 0x7F, 0x30, 0x18, 0x30, 0x7F, 0x7F,	// U+0057 W
+	0x43, 0x67, 0x3C, 0x18, 0x3C, 0x67, 0x43,	// U+0058 X
+	0x07, 0x4F, 0x78, 0x78, 0x4F, 0x07,	// U+0059 Y
+	0x47, 0x63, 0x71, 0x59, 0x4D, 0x67, 0x73,	// U+005A Z
+	0x7F, 0x7F, 0x41, 0x41,	// U+005B [
+	0x01, 0x03, 0x06, 0x0C, 0x18, 0x30, 0x60,	// U+005C 
+	0x41, 0x41, 0x7F, 0x7F,	// U+005D ]
+	0x08, 0x0C, 0x06, 0x03, 0x06, 0x0C, 0x08,	// U+005E ^
+	0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,	// U+005F _
+	0x03, 0x07, 0x04,	// U+0060 `
+	0x20, 0x74, 0x54, 0x54, 0x3C, 0x78, 0x40,	// U+0061 a
+	0x41, 0x7F, 0x3F, 0x48, 0x48, 0x78, 0x30,	// U+0062 b
+	0x38, 0x7C, 0x44, 0x44, 0x6C, 0x28,	// U+0063 c
+	0x30, 0x78, 0x48, 0x49, 0x3F, 0x7F, 0x40,	// U+0064 d
+	0x38, 0x7C, 0x54, 0x54, 0x5C, 0x18,	// U+0065 e
+	0x48, 0x7E, 0x7F, 0x49, 0x03, 0x02,	// U+0066 f
+	0x98, 0xBC, 0xA4, 0xA4, 0xF8, 0x7C, 0x04,	// U+0067 g
+	0x41, 0x7F, 0x7F, 0x08, 0x04, 0x7C, 0x78,	// U+0068 h
+	0x44, 0x7D, 0x7D, 0x40,	// U+0069 i
+	0x60, 0xE0, 0x80, 0x80, 0xFD, 0x7D,	// U+006A j
+	0x41, 0x7F, 0x7F, 0x10, 0x38, 0x6C, 0x44,	// U+006B k
+	0x41, 0x7F, 0x7F, 0x40,	// U+006C l
+	0x7C, 0x7C, 0x18, 0x38, 0x1C, 0x7C, 0x78,	// U+006D m
+	0x7C, 0x7C, 0x04, 0x04, 0x7C, 0x78,	// U+006E n
+	0x38, 0x7C, 0x44, 0x44, 0x7C, 0x38,	// U+006F o
+	0x84, 0xFC, 0xF8, 0xA4, 0x24, 0x3C, 0x18,	// U+0070 p
+	0x18, 0x3C, 0x24, 0xA4, 0xF8, 0xFC, 0x84,	// U+0071 q
+	0x44, 0x7C, 0x78, 0x4C, 0x04, 0x1C, 0x18,	// U+0072 r
+	0x48, 0x5C, 0x54, 0x54, 0x74, 0x24,	// U+0073 s
+	0x04, 0x3E, 0x7F, 0x44, 0x24,	// U+0074 t
+	0x3C, 0x7C, 0x40, 0x40, 0x3C, 0x7C, 0x40,	// U+0075 u
+	0x1C, 0x3C, 0x60, 0x60, 0x3C, 0x1C,	// U+0076 v
+	0x3C, 0x7C, 0x70, 0x38, 0x70, 0x7C, 0x3C,	// U+0077 w
+	0x44, 0x6C, 0x38, 0x10, 0x38, 0x6C, 0x44,	// U+0078 x
+	0x9C, 0xBC, 0xA0, 0xA0, 0xFC, 0x7C,	// U+0079 y
+	0x4C, 0x64, 0x74, 0x5C, 0x4C, 0x64,	// U+007A z
+	0x08, 0x08, 0x3E, 0x77, 0x41, 0x41,	// U+007B {
+	0x77, 0x77,	// U+007C |
+	0x41, 0x41, 0x77, 0x3E, 0x08, 0x08,	// U+007D }
+	0x02, 0x03, 0x01, 0x03, 0x02, 0x03, 0x01,	// U+007E ~
+	0x02, 0x07, 0x05, 0x07, 0x02,	// U+00B0 °
+	0x78, 0x7C, 0x15, 0x15, 0x7C, 0x78,	// U+00C5 Å
+	0x7E, 0x7F, 0x09, 0x7F, 0x7F, 0x49, 0x41,	// U+00C6 Æ
+	0x5C, 0x3E, 0x73, 0x49, 0x67, 0x3E, 0x1D,	// U+00D8 Ø
+	0x20, 0x74, 0x57, 0x57, 0x3C, 0x78, 0x40,	// U+00E5 å
+	0x20, 0x54, 0x54, 0x38, 0x7C, 0x54, 0x58,	// U+00E6 æ
+	0x38, 0x7C, 0x54, 0x56, 0x5F, 0x19,	// U+00E9 é
+	0xB8, 0x7C, 0x64, 0x54, 0x7C, 0x3E,	// U+00F8 ø
+};
+
+static const ssd1306_glyph_t font_prop8_glyphs[] = {
+	{     0,  0,  0,  3 },	// U+0020
+	{     0,  4,  0,  5 },	// U+0021
+	{     4,  5,  0,  6 },	// U+0022
+	{     9,  7,  0,  8 },	// U+0023
+	{    16,  6,  0,  7 },	// U+0024
+	{    22,  7,  0,  8 },	// U+0025
+	{    29,  7,  0,  8 },	// U+0026
+	{    36,  3,  0,  4 },	// U+0027
+	{    39,  4,  0,  5 },	// U+0028
+	{    43,  4,  0,  5 },	// U+0029
+	{    47,  8,  0,  9 },	// U+002A
+	{    55,  6,  0,  7 },	// U+002B
+	{    61,  3,  0,  4 },	// U+002C
+	{    64,  6,  0,  7 },	// U+002D
+	{    70,  2,  0,  3 },	// U+002E
+	{    72,  7,  0,  8 },	// U+002F
+	{    79,  7,  0,  8 },	// U+0030
+	{    86,  6,  0,  7 },	// U+0031
+	{    92,  6,  0,  7 },	// U+0032
+	{    98,  6,  0,  7 },	// U+0033
+	{   104,  7,  0,  8 },	// U+0034
+	{   111,  6,  0,  7 },	// U+0035
+	{   117,  6,  0,  7 },	// U+0036
+	{   123,  6,  0,  7 },	// U+0037
+	{   129,  6,  0,  7 },	// U+0038
+	{   135,  6,  0,  7 },	// U+0039
+	{   141,  2,  0,  3 },	// U+003A
+	{   143,  3,  0,  4 },	// U+003B
+	{   146,  5,  0,  6 },	// U+003C
+	{   151,  6,  0,  7 },	// U+003D
+	{   157,  5,  0,  6 },	// U+003E
+	{   162,  6,  0,  7 },	// U+003F
+	{   168,  7,  0,  8 },	// U+0040
+	{   175,  6,  0,  7 },	// U+0041
+	{   181,  7,  0,  8 },	// U+0042
+	{   188,  7,  0,  8 },	// U+0043
+	{   195,  7,  0,  8 },	// U+0044
+	{   202,  7,  0,  8 },	// U+0045
+	{   209,  7,  0,  8 },	// U+0046
+	{   216,  7,  0,  8 },	// U+0047
+	{   223,  6,  0,  7 },	// U+0048
+	{   229,  4,  0,  5 },	// U+0049
+	{   233,  7,  0,  8 },	// U+004A
+	{   240,  7,  0,  8 },	// U+004B
+	{   247,  7,  0,  8 },	// U+004C
+	{   254,  7,  0,  8 },	// U+004D
+	{   261,  7,  0,  8 },	// U+004E
+	{   268,  7,  0,  8 },	// U+004F
+	{   275,  7,  0,  8 },	// U+0050
+	{   282,  6,  0,  7 },	// U+0051
+	{   288,  7,  0,  8 },	// U+0052
+	{   295,  6,  0,  7 },	// U+0053
+	{   301,  6,  0,  7 },	// U+0054
+	{   307,  6,  0,  7 },	// U+0055
+	{   313,  6,  0,  7 },	// U+0056
+	{   319,  7,  0,  8 },	// U+0057
+	{   326,  7,  0,  8 },	// U+0058
+	{   333,  6,  0,  7 },	// U+0059
+	{   339,  7,  0,  8 },	// U+005A
+	{   346,  4,  0,  5 },	// U+005B
+	{   350,  7,  0,  8 },	// U+005C
+	{   357,  4,  0,  5 },	// U+005D
+	{   361,  7,  0,  8 },	// U+005E
+	{   368,  8,  0,  9 },	// U+005F
+	{   376,  3,  0,  4 },	// U+0060
+	{   379,  7,  0,  8 },	// U+0061
+	{   386,  7,  0,  8 },	// U+0062
+	{   393,  6,  0,  7 },	// U+0063
+	{   399,  7,  0,  8 },	// U+0064
+	{   406,  6,  0,  7 },	// U+0065
+	{   412,  6,  0,  7 },	// U+0066
+	{   418,  7,  0,  8 },	// U+0067
+	{   425,  7,  0,  8 },	// U+0068
+	{   432,  4,  0,  5 },	// U+0069
+	{   436,  6,  0,  7 },	// U+006A
+	{   442,  7,  0,  8 },	// U+006B
+	{   449,  4,  0,  5 },	// U+006C
+	{   453,  7,  0,  8 },	// U+006D
+	{   460,  6,  0,  7 },	// U+006E
+	{   466,  6,  0,  7 },	// U+006F
+	{   472,  7,  0,  8 },	// U+0070
+	{   479,  7,  0,  8 },	// U+0071
+	{   486,  7,  0,  8 },	// U+0072
+	{   493,  6,  0,  7 },	// U+0073
+	{   499,  5,  0,  6 },	// U+0074
+	{   504,  7,  0,  8 },	// U+0075
+	{   511,  6,  0,  7 },	// U+0076
+	{   517,  7,  0,  8 },	// U+0077
+	{   524,  7,  0,  8 },	// U+0078
+	{   531,  6,  0,  7 },	// U+0079
+	{   537,  6,  0,  7 },	// U+007A
+	{   543,  6,  0,  7 },	// U+007B
+	{   549,  2,  0,  3 },	// U+007C
+	{   551,  6,  0,  7 },	// U+007D
+	{   557,  7,  0,  8 },	// U+007E
+	{   564,  5,  0,  6 },	// U+00B0
+	{   569,  6,  0,  7 },	// U+00C5
+	{   575,  7,  0,  8 },	// U+00C6
+	{   582,  7,  0,  8 },	// U+00D8
+	{   589,  7,  0,  8 },	// U+00E5
+	{   596,  7,  0,  8 },	// U+00E6
+	{   603,  6,  0,  7 },	// U+00E9
+	{   609,  6,  0,  7 },	// U+00F8
+};
+
+static const uint8_t font_prop8_ext_index[] = {
+	 95,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,	// U+00B0
+	  0,   0,   0,   0,   0,  96,  97,   0,   0,   0,   0,   0,   0,   0,   0,   0,	// U+00C0
+	  0,   0,   0,   0,   0,   0,   0,   0,  98,   0,   0,   0,   0,   0,   0,   0,	// U+00D0
+	  0,   0,   0,   0,   0,  99, 100,   0,   0, 101,   0,   0,   0,   0,   0,   0,	// U+00E0
+	  0,   0,   0,   0,   0,   0,   0,   0, 102,	// U+00F0
+};
+
+const ssd1306_font_t font_prop8 = {
+	.height = 8,
+	.first = 0x0020,
+	.last = 0x007E,
+	.glyphs = font_prop8_glyphs,
+	.bitmap = font_prop8_bitmap,
+	.ext_first = 0x00B0,
+	.ext_last = 0x00F8,
+	.ext_index = font_prop8_ext_index,
+};
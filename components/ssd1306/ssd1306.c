@@ -1,32 +1,107 @@
 #include <string.h>
+#include <inttypes.h>
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/semphr.h"
 
 #include "esp_log.h"
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
 
 #include "ssd1306.h"
 #include "font8x8_basic.h"
 
 #define TAG "SSD1306"
 
-#define PACK8 __attribute__((aligned( __alignof__( uint8_t ) ), packed ))
+// Approximate bytes on the bus besides the image data
+#define PAGE_WRITE_OVERHEAD 10 // Addressing transaction plus control byte of the data transaction
+#define FRAME_WRITE_OVERHEAD 16 // Addressing commands and control byte of a full frame
 
-typedef union out_column_t {
-	uint32_t u32;
-	uint8_t  u8[4];
-} PACK8 out_column_t;
+static void ssd1306_bus_take(SSD1306_t * dev);
+static uint32_t ssd1306_bus_give(SSD1306_t * dev);
 
+// dev must start zeroed, e.g. static. Calling it again keeps the buffers, the bus lock and the
+// flush task of the first call.
 void ssd1306_init(SSD1306_t * dev, int width, int height)
 {
+	dev->_contrast = 0xFF; // Set by the transport's init sequence
+	dev->_animReady = false;
+	dev->_animSteps = 0;
+	if (dev->_busLock == NULL) {
+		dev->_busLock = xSemaphoreCreateMutex();
+	}
+	memset(&dev->_stats, 0, sizeof(dev->_stats));
+
+	// The transfer path and the transitions reuse these buffers, so nothing is allocated per frame
+	if (dev->_tx_buf == NULL) {
+		dev->_tx_buf = ssd1306_alloc(dev, SSD1306_TX_BUF_LEN, MALLOC_CAP_DMA);
+		if (dev->_tx_buf == NULL) {
+			ESP_LOGE(TAG, "tx buffer alloc fail");
+		}
+	}
+	if (dev->_anim == NULL) {
+		dev->_anim = ssd1306_alloc(dev, SSD1306_FB_LEN * 2, MALLOC_CAP_8BIT);
+		if (dev->_anim == NULL) {
+			ESP_LOGE(TAG, "anim buffer alloc fail");
+		}
+	}
+#if CONFIG_SH1106_CONTROLLER
+	dev->_controller = CONTROLLER_SH1106;
+#else
+	dev->_controller = CONTROLLER_SSD1306;
+#endif
+	dev->_horizontal = false;
+
+	ssd1306_bus_take(dev);
 	if (dev->_address == SPI_ADDRESS) {
 		spi_init(dev, width, height);
 	} else {
 		i2c_init(dev, width, height);
 	}
+	ssd1306_bus_give(dev);
 	// Initialize internal buffer
-	for (int i=0;i<dev->_pages;i++) {
-		memset(dev->_page[i]._segs, 0, 128);
+	memset(dev->_fb, 0, sizeof(dev->_fb));
+	// GDDRAM content is undefined after reset, so the first flush sends everything
+	ssd1306_clear_dirty(dev);
+	for (int page=0;page<dev->_pages;page++) {
+		ssd1306_mark_dirty(dev, page, 0, dev->_width);
+	}
+}
+
+// Every heap allocation of the driver and of the widgets drawn through it goes through here,
+// so ssd1306_get_allocs() tells whether drawing a frame touched the heap.
+void * ssd1306_alloc(SSD1306_t * dev, size_t size, uint32_t caps)
+{
+	void * ptr = heap_caps_malloc(size, caps);
+	if (ptr != NULL) {
+		dev->_allocs++;
+	}
+	return ptr;
+}
+
+// Allocations made by ssd1306_alloc since the first ssd1306_init
+uint32_t ssd1306_get_allocs(SSD1306_t * dev)
+{
+	return dev->_allocs;
+}
+
+// Send the init sequence again, e.g. after a failed transfer cut a command short.
+// The buffer is kept and sent in full by the next flush.
+void ssd1306_reinit(SSD1306_t * dev)
+{
+	ssd1306_flush_wait(dev);
+	ssd1306_bus_take(dev);
+	if (dev->_address == SPI_ADDRESS) {
+		spi_init(dev, dev->_width, dev->_height);
+	} else {
+		i2c_init(dev, dev->_width, dev->_height);
+	}
+	dev->_contrast = 0xFF;
+	dev->_horizontal = false;
+	ssd1306_bus_give(dev);
+	for (int page=0;page<dev->_pages;page++) {
+		ssd1306_mark_dirty(dev, page, 0, dev->_width);
 	}
 }
 
@@ -45,63 +120,424 @@ int ssd1306_get_pages(SSD1306_t * dev)
 	return dev->_pages;
 }
 
-void ssd1306_show_buffer(SSD1306_t * dev)
+// _tx_buf and the panel addressing state are shared by every writer, so
+// transfers from the flush task and from write-through calls are serialized.
+// The time between take and give is accounted as bus time.
+static void ssd1306_bus_take(SSD1306_t * dev)
 {
-	if (dev->_address == SPI_ADDRESS) {
+	if (dev->_busLock != NULL) xSemaphoreTake(dev->_busLock, portMAX_DELAY);
+	dev->_busTakenAt = esp_timer_get_time();
+}
+
+// Returns the microseconds the bus was held
+static uint32_t ssd1306_bus_give(SSD1306_t * dev)
+{
+	uint32_t elapsed = esp_timer_get_time() - dev->_busTakenAt;
+	dev->_stats.tx_time_us += elapsed;
+	if (dev->_busLock != NULL) xSemaphoreGive(dev->_busLock);
+	return elapsed;
+}
+
+// Called with the bus held, after the transfer of a flush
+static void ssd1306_count_flush(SSD1306_t * dev, uint32_t elapsed)
+{
+	dev->_stats.flushes++;
+	dev->_stats.last_flush_us = elapsed;
+	if (elapsed > dev->_stats.max_flush_us) dev->_stats.max_flush_us = elapsed;
+}
+
+// Called by the transports after every bus transaction, with the bus held
+void ssd1306_count_transfer(SSD1306_t * dev, int command_bytes, int payload_bytes, bool ok)
+{
+	dev->_stats.transactions++;
+	dev->_stats.command_bytes += command_bytes;
+	dev->_stats.payload_bytes += payload_bytes;
+	if (!ok) dev->_stats.errors++;
+}
+
+// Page bytes with the bit order reversed, for panels mounted upside down
+static const uint8_t ssd1306_bit_reverse[256] = {
+	0x00, 0x80, 0x40, 0xC0, 0x20, 0xA0, 0x60, 0xE0, 0x10, 0x90, 0x50, 0xD0, 0x30, 0xB0, 0x70, 0xF0,
+	0x08, 0x88, 0x48, 0xC8, 0x28, 0xA8, 0x68, 0xE8, 0x18, 0x98, 0x58, 0xD8, 0x38, 0xB8, 0x78, 0xF8,
+	0x04, 0x84, 0x44, 0xC4, 0x24, 0xA4, 0x64, 0xE4, 0x14, 0x94, 0x54, 0xD4, 0x34, 0xB4, 0x74, 0xF4,
+	0x0C, 0x8C, 0x4C, 0xCC, 0x2C, 0xAC, 0x6C, 0xEC, 0x1C, 0x9C, 0x5C, 0xDC, 0x3C, 0xBC, 0x7C, 0xFC,
+	0x02, 0x82, 0x42, 0xC2, 0x22, 0xA2, 0x62, 0xE2, 0x12, 0x92, 0x52, 0xD2, 0x32, 0xB2, 0x72, 0xF2,
+	0x0A, 0x8A, 0x4A, 0xCA, 0x2A, 0xAA, 0x6A, 0xEA, 0x1A, 0x9A, 0x5A, 0xDA, 0x3A, 0xBA, 0x7A, 0xFA,
+	0x06, 0x86, 0x46, 0xC6, 0x26, 0xA6, 0x66, 0xE6, 0x16, 0x96, 0x56, 0xD6, 0x36, 0xB6, 0x76, 0xF6,
+	0x0E, 0x8E, 0x4E, 0xCE, 0x2E, 0xAE, 0x6E, 0xEE, 0x1E, 0x9E, 0x5E, 0xDE, 0x3E, 0xBE, 0x7E, 0xFE,
+	0x01, 0x81, 0x41, 0xC1, 0x21, 0xA1, 0x61, 0xE1, 0x11, 0x91, 0x51, 0xD1, 0x31, 0xB1, 0x71, 0xF1,
+	0x09, 0x89, 0x49, 0xC9, 0x29, 0xA9, 0x69, 0xE9, 0x19, 0x99, 0x59, 0xD9, 0x39, 0xB9, 0x79, 0xF9,
+	0x05, 0x85, 0x45, 0xC5, 0x25, 0xA5, 0x65, 0xE5, 0x15, 0x95, 0x55, 0xD5, 0x35, 0xB5, 0x75, 0xF5,
+	0x0D, 0x8D, 0x4D, 0xCD, 0x2D, 0xAD, 0x6D, 0xED, 0x1D, 0x9D, 0x5D, 0xDD, 0x3D, 0xBD, 0x7D, 0xFD,
+	0x03, 0x83, 0x43, 0xC3, 0x23, 0xA3, 0x63, 0xE3, 0x13, 0x93, 0x53, 0xD3, 0x33, 0xB3, 0x73, 0xF3,
+	0x0B, 0x8B, 0x4B, 0xCB, 0x2B, 0xAB, 0x6B, 0xEB, 0x1B, 0x9B, 0x5B, 0xDB, 0x3B, 0xBB, 0x7B, 0xFB,
+	0x07, 0x87, 0x47, 0xC7, 0x27, 0xA7, 0x67, 0xE7, 0x17, 0x97, 0x57, 0xD7, 0x37, 0xB7, 0x77, 0xF7,
+	0x0F, 0x8F, 0x4F, 0xCF, 0x2F, 0xAF, 0x6F, 0xEF, 0x1F, 0x9F, 0x5F, 0xDF, 0x3F, 0xBF, 0x7F, 0xFF,
+};
+
+// Copy width segments of one page into a transfer buffer in panel orientation.
+// Drawing always works on an upright buffer; the transports apply _flip here,
+// together with the page order, when the data goes out.
+void ssd1306_copy_segs(SSD1306_t * dev, uint8_t * dst, const uint8_t * src, int width)
+{
+	if (!dev->_flip) {
+		memcpy(dst, src, width);
+		return;
+	}
+	for (int seg=0;seg<width;seg++) {
+		dst[seg] = ssd1306_bit_reverse[src[seg]];
+	}
+}
+
+// Copy the counters. Waits for a transfer in progress to finish.
+void ssd1306_get_bus_stats(SSD1306_t * dev, ssd1306_bus_stats_t * stats)
+{
+	if (dev->_busLock != NULL) xSemaphoreTake(dev->_busLock, portMAX_DELAY);
+	*stats = dev->_stats;
+	if (dev->_busLock != NULL) xSemaphoreGive(dev->_busLock);
+}
+
+void ssd1306_reset_bus_stats(SSD1306_t * dev)
+{
+	if (dev->_busLock != NULL) xSemaphoreTake(dev->_busLock, portMAX_DELAY);
+	memset(&dev->_stats, 0, sizeof(dev->_stats));
+	if (dev->_busLock != NULL) xSemaphoreGive(dev->_busLock);
+}
+
+void ssd1306_log_bus_stats(SSD1306_t * dev, const char * label, const ssd1306_bus_stats_t * stats)
+{
+	ssd1306_bus_stats_t current;
+	if (stats == NULL) {
+		ssd1306_get_bus_stats(dev, &current);
+		stats = &current;
+	}
+	uint32_t average = stats->flushes ? stats->tx_time_us / stats->flushes : 0;
+	ESP_LOGI(TAG, "%s: %"PRIu32" flushes, %"PRIu32" transactions, %"PRIu32" payload + %"PRIu32" command bytes, %"PRIu32" errors, "
+		"bus %"PRIu64" us (avg %"PRIu32" us, last %"PRIu32" us, max %"PRIu32" us per flush)",
+		label ? label : "bus", stats->flushes, stats->transactions, stats->payload_bytes, stats->command_bytes, stats->errors,
+		stats->tx_time_us, average, stats->last_flush_us, stats->max_flush_us);
+}
+
+// Send the whole frame held in pages.
+// SSD1306 uses horizontal addressing and needs one transaction.
+// SH1106 only supports page addressing and needs one write per page.
+static void ssd1306_send_frame(SSD1306_t * dev, PAGE_t * pages)
+{
+	ssd1306_bus_take(dev);
+	if (dev->_controller == CONTROLLER_SH1106) {
 		for (int page=0; page<dev->_pages;page++) {
-			spi_display_image(dev, page, 0, dev->_page[page]._segs, dev->_width);
+			if (dev->_address == SPI_ADDRESS) {
+				spi_display_image(dev, page, 0, pages[page]._segs, dev->_width);
+			} else {
+				i2c_display_image(dev, page, 0, pages[page]._segs, dev->_width);
+			}
 		}
 	} else {
+		if (dev->_address == SPI_ADDRESS) {
+			spi_display_frame(dev, pages);
+		} else {
+			i2c_display_frame(dev, pages);
+		}
+	}
+	ssd1306_count_flush(dev, esp_timer_get_time() - dev->_busTakenAt);
+	ssd1306_bus_give(dev);
+}
+
+// Send the dirty span of each page, or a full frame when that is cheaper
+static void ssd1306_send_pages(SSD1306_t * dev, PAGE_t * pages, int * dirtyStart, int * dirtyEnd)
+{
+	if (dev->_controller == CONTROLLER_SSD1306) {
+		int cost = 0;
 		for (int page=0; page<dev->_pages;page++) {
-			i2c_display_image(dev, page, 0, dev->_page[page]._segs, dev->_width);
+			if (dirtyEnd[page] < dirtyStart[page]) continue;
+			cost = cost + (dirtyEnd[page] - dirtyStart[page] + 1) + PAGE_WRITE_OVERHEAD;
+		}
+		if (cost >= dev->_pages * dev->_width + FRAME_WRITE_OVERHEAD) {
+			ssd1306_send_frame(dev, pages);
+			return;
+		}
+	}
+
+	ssd1306_bus_take(dev);
+	for (int page=0; page<dev->_pages;page++) {
+		int start = dirtyStart[page];
+		int end = dirtyEnd[page];
+		if (end < start) continue;
+		ESP_LOGD(TAG, "send_pages page=%d seg=%d-%d", page, start, end);
+		if (dev->_address == SPI_ADDRESS) {
+			spi_display_image(dev, page, start, &pages[page]._segs[start], end - start + 1);
+		} else {
+			i2c_display_image(dev, page, start, &pages[page]._segs[start], end - start + 1);
 		}
 	}
+	ssd1306_count_flush(dev, esp_timer_get_time() - dev->_busTakenAt);
+	ssd1306_bus_give(dev);
 }
 
-void ssd1306_set_buffer(SSD1306_t * dev, uint8_t * buffer)
+// Send only the dirty span of each page.
+// When the flush task is running this hands the buffer over and returns immediately.
+void ssd1306_show_buffer(SSD1306_t * dev)
 {
-	int index = 0;
+	if (dev->_flushTask != NULL) {
+		ssd1306_swap_buffer(dev);
+		return;
+	}
+	ssd1306_send_pages(dev, dev->_page, dev->_dirtyStart, dev->_dirtyEnd);
+	ssd1306_clear_dirty(dev);
+}
+
+// Send the whole buffer
+void ssd1306_show_frame(SSD1306_t * dev)
+{
+	if (dev->_flushTask != NULL) {
+		for (int page=0; page<dev->_pages;page++) {
+			ssd1306_mark_dirty(dev, page, 0, dev->_width);
+		}
+		ssd1306_swap_buffer(dev);
+		return;
+	}
+	ssd1306_send_frame(dev, dev->_page);
+	ssd1306_clear_dirty(dev);
+}
+
+// Copy the dirty spans of the back buffer (_page) into the front buffer and wake the flush task.
+// The flush task holds _frontLock only while copying, so this never waits for the bus.
+void ssd1306_swap_buffer(SSD1306_t * dev)
+{
+	if (dev->_flushTask == NULL) {
+		ssd1306_show_buffer(dev);
+		return;
+	}
+
+	xSemaphoreTake(dev->_frontLock, portMAX_DELAY);
 	for (int page=0; page<dev->_pages;page++) {
-		memcpy(&dev->_page[page]._segs, &buffer[index], 128);
-		index = index + 128;
+		int start = dev->_dirtyStart[page];
+		int end = dev->_dirtyEnd[page];
+		if (end < start) continue;
+		memcpy(&dev->_front[page]._segs[start], &dev->_page[page]._segs[start], end - start + 1);
+		if (dev->_frontDirtyEnd[page] < dev->_frontDirtyStart[page]) {
+			dev->_frontDirtyStart[page] = start;
+			dev->_frontDirtyEnd[page] = end;
+		} else {
+			if (start < dev->_frontDirtyStart[page]) dev->_frontDirtyStart[page] = start;
+			if (end > dev->_frontDirtyEnd[page]) dev->_frontDirtyEnd[page] = end;
+		}
 	}
+	dev->_swapCount++;
+	xSemaphoreGive(dev->_frontLock);
+	ssd1306_clear_dirty(dev);
+	xTaskNotifyGive(dev->_flushTask);
 }
 
-void ssd1306_get_buffer(SSD1306_t * dev, uint8_t * buffer)
+// Transmit the front buffer whenever ssd1306_swap_buffer hands over a new one.
+// Swaps that arrive during a transfer are coalesced into the next one.
+static void ssd1306_flush_task(void * pvParameter)
 {
-	int index = 0;
+	SSD1306_t * dev = (SSD1306_t *)pvParameter;
+	PAGE_t * pages = &dev->_front[8]; // Second half of the _front allocation, DMA capable
+	int dirtyStart[8];
+	int dirtyEnd[8];
+
+	while (1) {
+		ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+		// Take a private copy so producers can swap again while we are on the bus
+		xSemaphoreTake(dev->_frontLock, portMAX_DELAY);
+		uint32_t swapCount = dev->_swapCount;
+		memcpy(pages, dev->_front, dev->_pages * 128);
+		for (int page=0; page<8;page++) {
+			dirtyStart[page] = dev->_frontDirtyStart[page];
+			dirtyEnd[page] = dev->_frontDirtyEnd[page];
+			dev->_frontDirtyStart[page] = 0;
+			dev->_frontDirtyEnd[page] = -1;
+		}
+		xSemaphoreGive(dev->_frontLock);
+
+		ssd1306_send_pages(dev, pages, dirtyStart, dirtyEnd);
+		dev->_flushedCount = swapCount;
+	}
+}
+
+// Start the task that owns the bus for ssd1306_show_buffer.
+// After this, drawing tasks only copy into the front buffer and never wait for the transfer.
+void ssd1306_start_flush_task(SSD1306_t * dev, int priority)
+{
+	if (dev->_flushTask != NULL) return;
+
+	// The front buffer and the flush task's private copy of it
+	dev->_front = ssd1306_alloc(dev, SSD1306_FB_LEN * 2, MALLOC_CAP_DMA);
+	dev->_frontLock = xSemaphoreCreateMutex();
+	if (dev->_front == NULL || dev->_frontLock == NULL) {
+		ESP_LOGE(TAG, "flush task alloc fail");
+		return;
+	}
+	memcpy(dev->_front, dev->_fb, SSD1306_FB_LEN);
+	for (int page=0; page<8;page++) {
+		dev->_frontDirtyStart[page] = 0;
+		dev->_frontDirtyEnd[page] = -1;
+	}
+
+	if (xTaskCreate(ssd1306_flush_task, "ssd1306_flush", 4096, (void *)dev, priority, &dev->_flushTask) != pdPASS) {
+		ESP_LOGE(TAG, "flush task create fail");
+		dev->_flushTask = NULL;
+	}
+}
+
+// Wait until every swap handed to the flush task so far is on the panel
+void ssd1306_flush_wait(SSD1306_t * dev)
+{
+	if (dev->_flushTask == NULL) return;
+	xSemaphoreTake(dev->_frontLock, portMAX_DELAY);
+	uint32_t swapCount = dev->_swapCount;
+	xSemaphoreGive(dev->_frontLock);
+	while ((int32_t)(swapCount - dev->_flushedCount) > 0) {
+		vTaskDelay(1);
+	}
+}
+
+void ssd1306_set_controller(SSD1306_t * dev, ssd1306_controller_t controller)
+{
+	dev->_controller = controller;
+}
+
+// Record that segments [seg, seg+width) of page no longer match the panel
+void ssd1306_mark_dirty(SSD1306_t * dev, int page, int seg, int width)
+{
+	if (page < 0 || page >= dev->_pages) return;
+	int start = seg;
+	int end = seg + width - 1;
+	if (start < 0) start = 0;
+	if (end >= dev->_width) end = dev->_width - 1;
+	if (end < start) return;
+	if (dev->_dirtyEnd[page] < dev->_dirtyStart[page]) {
+		dev->_dirtyStart[page] = start;
+		dev->_dirtyEnd[page] = end;
+	} else {
+		if (start < dev->_dirtyStart[page]) dev->_dirtyStart[page] = start;
+		if (end > dev->_dirtyEnd[page]) dev->_dirtyEnd[page] = end;
+	}
+}
+
+void ssd1306_clear_dirty(SSD1306_t * dev)
+{
+	for (int page=0; page<8; page++) {
+		dev->_dirtyStart[page] = 0;
+		dev->_dirtyEnd[page] = -1;
+	}
+}
+
+// Copy one page of segments into the internal buffer, marking only the span that changed.
+// row is word aligned like _fb, so the compare runs a word at a time.
+static void ssd1306_store_page(SSD1306_t * dev, int page, const uint32_t * row)
+{
+	uint32_t * words = &dev->_fbWords[page * 128 / 4];
+	int first = 0;
+	int last = (dev->_width + 3) / 4 - 1;
+	while (first <= last && words[first] == row[first]) first++;
+	if (first > last) return;
+	while (words[last] == row[last]) last--;
+
+	// Narrow the span to the bytes that differ inside the first and last word
+	const uint8_t * src = (const uint8_t *)row;
+	uint8_t * segs = dev->_page[page]._segs;
+	int start = first * 4;
+	int end = last * 4 + 3;
+	while (segs[start] == src[start]) start++;
+	while (segs[end] == src[end]) end--;
+	memcpy(&segs[start], &src[start], end - start + 1);
+	ssd1306_mark_dirty(dev, page, start, end - start + 1);
+}
+
+// Load a whole frame, page after page. A word aligned buffer is compared
+// with the current one, so only what changed is sent.
+void ssd1306_set_buffer(SSD1306_t * dev, uint8_t * buffer)
+{
+	if (((uintptr_t)buffer & 0x03) == 0) {
+		for (int page=0; page<dev->_pages;page++) {
+			ssd1306_store_page(dev, page, (const uint32_t *)&buffer[page * 128]);
+		}
+		return;
+	}
+	memcpy(dev->_fb, buffer, dev->_pages * 128);
 	for (int page=0; page<dev->_pages;page++) {
-		memcpy(&buffer[index], &dev->_page[page]._segs, 128);
-		index = index + 128;
+		ssd1306_mark_dirty(dev, page, 0, dev->_width);
 	}
 }
 
-void ssd1306_display_image(SSD1306_t * dev, int page, int seg, uint8_t * images, int width)
+void ssd1306_get_buffer(SSD1306_t * dev, uint8_t * buffer)
+{
+	memcpy(buffer, dev->_fb, dev->_pages * 128);
+}
+
+// Send segments of the internal buffer, through the flush task when it is running
+static void ssd1306_show_segs(SSD1306_t * dev, int page, int seg, int width)
 {
+	if (dev->_flushTask != NULL) {
+		ssd1306_mark_dirty(dev, page, seg, width);
+		ssd1306_swap_buffer(dev);
+		return;
+	}
+	ssd1306_bus_take(dev);
 	if (dev->_address == SPI_ADDRESS) {
-		spi_display_image(dev, page, seg, images, width);
+		spi_display_image(dev, page, seg, &dev->_page[page]._segs[seg], width);
 	} else {
-		i2c_display_image(dev, page, seg, images, width);
+		i2c_display_image(dev, page, seg, &dev->_page[page]._segs[seg], width);
 	}
+	ssd1306_bus_give(dev);
+}
+
+void ssd1306_display_image(SSD1306_t * dev, int page, int seg, uint8_t * images, int width)
+{
 	// Set to internal buffer
-	memcpy(&dev->_page[page]._segs[seg], images, width);
+	if (images != &dev->_page[page]._segs[seg]) {
+		memcpy(&dev->_page[page]._segs[seg], images, width);
+	}
+	ssd1306_show_segs(dev, page, seg, width);
 }
 
-void ssd1306_display_text(SSD1306_t * dev, int page, char * text, int text_len, bool invert)
+// Set image to internal buffer. Not show it.
+void _ssd1306_display_image(SSD1306_t * dev, int page, int seg, uint8_t * images, int width)
 {
 	if (page >= dev->_pages) return;
+	if (seg >= dev->_width) return;
+	int _width = width;
+	if (seg + _width > dev->_width) _width = dev->_width - seg;
+	memcpy(&dev->_page[page]._segs[seg], images, _width);
+	ssd1306_mark_dirty(dev, page, seg, _width);
+}
+
+// Render up to 16 characters into a 128 segment line image
+static int ssd1306_render_text(SSD1306_t * dev, char * text, int text_len, bool invert, uint8_t * image)
+{
 	int _text_len = text_len;
 	if (_text_len > 16) _text_len = 16;
 
 	int seg = 0;
-	uint8_t image[8];
 	for (int i = 0; i < _text_len; i++) {
-		memcpy(image, font8x8_basic_tr[(uint8_t)text[i]], 8);
-		if (invert) ssd1306_invert(image, 8);
-		if (dev->_flip) ssd1306_flip(image, 8);
-		ssd1306_display_image(dev, page, seg, image, 8);
+		memcpy(&image[seg], font8x8_basic_tr[(uint8_t)text[i]], 8);
+		if (invert) ssd1306_invert(&image[seg], 8);
 		seg = seg + 8;
 	}
+	return seg;
+}
+
+void ssd1306_display_text(SSD1306_t * dev, int page, char * text, int text_len, bool invert)
+{
+	if (page >= dev->_pages) return;
+	uint8_t image[128];
+	int width = ssd1306_render_text(dev, text, text_len, invert, image);
+	if (width == 0) return;
+	ssd1306_display_image(dev, page, 0, image, width);
+}
+
+// Set text to internal buffer. Not show it.
+void _ssd1306_display_text(SSD1306_t * dev, int page, char * text, int text_len, bool invert)
+{
+	if (page >= dev->_pages) return;
+	uint8_t image[128];
+	int width = ssd1306_render_text(dev, text, text_len, invert, image);
+	if (width == 0) return;
+	_ssd1306_display_image(dev, page, 0, image, width);
 }
 
 void ssd1306_display_text_box1(SSD1306_t * dev, int page, int seg, char * text, int box_width, int text_len, bool invert, int delay)
@@ -115,7 +551,6 @@ void ssd1306_display_text_box1(SSD1306_t * dev, int page, int seg, char * text,
 	for (int i = 0; i < box_width; i++) {
 		memcpy(image, font8x8_basic_tr[(uint8_t)text[i]], 8);
 		if (invert) ssd1306_invert(image, 8);
-		if (dev->_flip) ssd1306_flip(image, 8);
 		ssd1306_display_image(dev, page, _seg, image, 8);
 		_seg = _seg + 8;
 	}
@@ -125,7 +560,6 @@ void ssd1306_display_text_box1(SSD1306_t * dev, int page, int seg, char * text,
 	for (int _text=box_width;_text<text_len;_text++) {
 		memcpy(image, font8x8_basic_tr[(uint8_t)text[_text]], 8);
 		if (invert) ssd1306_invert(image, 8);
-		if (dev->_flip) ssd1306_flip(image, 8);
 		for (int _bit=0;_bit<8;_bit++) {
 			for (int _pixel=0;_pixel<text_box_pixel;_pixel++) {
 				//ESP_LOGI(TAG, "_text=%d _bit=%d _pixel=%d", _text, _bit, _pixel);
@@ -152,7 +586,6 @@ void ssd1306_display_text_box2(SSD1306_t * dev, int page, int seg, char * text,
 		//memcpy(image, font8x8_basic_tr[(uint8_t)text[i]], 8);
 		memcpy(image, font8x8_basic_tr[0x20], 8);
 		if (invert) ssd1306_invert(image, 8);
-		if (dev->_flip) ssd1306_flip(image, 8);
 		ssd1306_display_image(dev, page, _seg, image, 8);
 		_seg = _seg + 8;
 	}
@@ -162,7 +595,6 @@ void ssd1306_display_text_box2(SSD1306_t * dev, int page, int seg, char * text,
 	for (int _text=0;_text<text_len;_text++) {
 		memcpy(image, font8x8_basic_tr[(uint8_t)text[_text]], 8);
 		if (invert) ssd1306_invert(image, 8);
-		if (dev->_flip) ssd1306_flip(image, 8);
 		for (int _bit=0;_bit<8;_bit++) {
 			for (int _pixel=0;_pixel<text_box_pixel;_pixel++) {
 				//ESP_LOGI(TAG, "_text=%d _bit=%d _pixel=%d", _text, _bit, _pixel);
@@ -178,7 +610,6 @@ void ssd1306_display_text_box2(SSD1306_t * dev, int page, int seg, char * text,
 	for (int _text=0;_text<box_width;_text++) {
 		memcpy(image, font8x8_basic_tr[0x20], 8);
 		if (invert) ssd1306_invert(image, 8);
-		if (dev->_flip) ssd1306_flip(image, 8);
 		for (int _bit=0;_bit<8;_bit++) {
 			for (int _pixel=0;_pixel<text_box_pixel;_pixel++) {
 				//ESP_LOGI(TAG, "_text=%d _bit=%d _pixel=%d", _text, _bit, _pixel);
@@ -191,58 +622,93 @@ void ssd1306_display_text_box2(SSD1306_t * dev, int page, int seg, char * text,
 	}
 }
 
-// by Coert Vonk
-void 
-ssd1306_display_text_x3(SSD1306_t * dev, int page, char * text, int text_len, bool invert)
+// Glyph of ch at scale, scale pages of 8*scale columns.
+// Characters the UI shows come from the const tables of font8x8_scaled.c; any other
+// is scaled into glyph, which must hold SSD1306_TEXT_SCALE_MAX pages of 8*SSD1306_TEXT_SCALE_MAX.
+static const uint8_t * ssd1306_scaled_glyph(uint8_t ch, int scale, uint8_t * glyph)
 {
-	if (page >= dev->_pages) return;
-	int _text_len = text_len;
-	if (_text_len > 5) _text_len = 5;
-
-	int seg = 0;
-
-	for (int nn = 0; nn < _text_len; nn++) {
+	if (ch >= 128) ch = 0;
+	if (scale == 1) return font8x8_basic_tr[ch];
+	int glyph_width = 8 * scale;
+	int index = font8x8_scaled_index[ch];
+	if (index >= 0) return &font8x8_scaled[scale][index * glyph_width * scale];
+
+	uint32_t out_bits = (1 << scale) - 1;
+	for (int xx = 0; xx < 8; xx++) { // for each column (x-direction)
+		// make the column scale times as high
+		uint32_t out_column = 0;
+		for (int yy = 0; yy < 8; yy++) { // for pixel (y-direction)
+			if (font8x8_basic_tr[ch][xx] & (1 << yy)) {
+				out_column |= out_bits << (yy * scale);
+			}
+		}
+		// and scale times as wide, in 8 column high pieces
+		for (int page = 0; page < scale; page++) {
+			memset(&glyph[page * glyph_width + xx * scale], (out_column >> (page * 8)) & 0xFF, scale);
+		}
+	}
+	return glyph;
+}
 
-		uint8_t const * const in_columns = font8x8_basic_tr[(uint8_t)text[nn]];
+// Render text scale times as large into the internal buffer, clipped to the panel.
+// Scale 1 places 8x8 text at any column.
+// Returns the number of segments written on each page.
+static int ssd1306_render_text_scaled(SSD1306_t * dev, int page, int seg, char * text, int text_len, int scale, bool invert)
+{
+	if (page < 0 || page >= dev->_pages) return 0;
+	if (seg < 0 || seg >= dev->_width) return 0;
+	if (scale < 1 || scale > SSD1306_TEXT_SCALE_MAX) return 0;
 
-		// make the character 3x as high
-		out_column_t out_columns[8];
-		memset(out_columns, 0, sizeof(out_columns));
+	uint8_t buffer[SSD1306_TEXT_SCALE_MAX * 8 * SSD1306_TEXT_SCALE_MAX];
+	int glyph_width = 8 * scale;
+	int _seg = seg;
+	for (int nn = 0; nn < text_len; nn++) {
+		if (_seg >= dev->_width) break;
+		int width = glyph_width;
+		if (_seg + width > dev->_width) width = dev->_width - _seg;
+
+		const uint8_t * glyph = ssd1306_scaled_glyph(text[nn], scale, buffer);
+		for (int yy = 0; yy < scale; yy++) {
+			if (page+yy >= dev->_pages) break;
+			uint8_t * out = &dev->_page[page+yy]._segs[_seg];
+			memcpy(out, &glyph[yy * glyph_width], width);
+			if (invert) ssd1306_invert(out, width);
+		}
+		_seg = _seg + width;
+	}
 
-		for (int xx = 0; xx < 8; xx++) { // for each column (x-direction)
+	for (int yy = 0; yy < scale; yy++) {
+		if (page+yy >= dev->_pages) break;
+		ssd1306_mark_dirty(dev, page+yy, seg, _seg - seg);
+	}
+	return _seg - seg;
+}
 
-			uint32_t in_bitmask = 0b1;
-			uint32_t out_bitmask = 0b111;
+void ssd1306_display_text_scaled(SSD1306_t * dev, int page, int seg, char * text, int text_len, int scale, bool invert)
+{
+	int width = ssd1306_render_text_scaled(dev, page, seg, text, text_len, scale, invert);
+	if (width == 0) return;
+	for (int yy = 0; yy < scale; yy++) {
+		if (page+yy >= dev->_pages) break;
+		ssd1306_show_segs(dev, page+yy, seg, width);
+	}
+}
 
-			for (int yy = 0; yy < 8; yy++) { // for pixel (y-direction)
-				if (in_columns[xx] & in_bitmask) {
-					out_columns[xx].u32 |= out_bitmask;
-				}
-				in_bitmask <<= 1;
-				out_bitmask <<= 3;
-			}
-		}
+// Render scaled text into internal buffer. Not show it.
+void _ssd1306_display_text_scaled(SSD1306_t * dev, int page, int seg, char * text, int text_len, int scale, bool invert)
+{
+	ssd1306_render_text_scaled(dev, page, seg, text, text_len, scale, invert);
+}
 
-		// render character in 8 column high pieces, making them 3x as wide
-		for (int yy = 0; yy < 3; yy++)	{ // for each group of 8 pixels high (y-direction)
+void ssd1306_display_text_x3(SSD1306_t * dev, int page, char * text, int text_len, bool invert)
+{
+	ssd1306_display_text_scaled(dev, page, 0, text, text_len, 3, invert);
+}
 
-			uint8_t image[24];
-			for (int xx = 0; xx < 8; xx++) { // for each column (x-direction)
-				image[xx*3+0] = 
-				image[xx*3+1] = 
-				image[xx*3+2] = out_columns[xx].u8[yy];
-			}
-			if (invert) ssd1306_invert(image, 24);
-			if (dev->_flip) ssd1306_flip(image, 24);
-			if (dev->_address == SPI_ADDRESS) {
-				spi_display_image(dev, page+yy, seg, image, 24);
-			} else {
-				i2c_display_image(dev, page+yy, seg, image, 24);
-			}
-			memcpy(&dev->_page[page+yy]._segs[seg], image, 24);
-		}
-		seg = seg + 24;
-	}
+// Render text x3 into internal buffer. Not show it.
+void _ssd1306_display_text_x3(SSD1306_t * dev, int page, char * text, int text_len, bool invert)
+{
+	_ssd1306_display_text_scaled(dev, page, 0, text, text_len, 3, invert);
 }
 
 void ssd1306_clear_screen(SSD1306_t * dev, bool invert)
@@ -261,13 +727,40 @@ void ssd1306_clear_line(SSD1306_t * dev, int page, bool invert)
 	ssd1306_display_text(dev, page, space, sizeof(space), invert);
 }
 
-void ssd1306_contrast(SSD1306_t * dev, int contrast)
+// Clear internal buffer. Not show it.
+void _ssd1306_clear_screen(SSD1306_t * dev, bool invert)
 {
+	memset(dev->_fb, invert ? 0xFF : 0x00, dev->_pages * 128);
+	for (int page = 0; page < dev->_pages; page++) {
+		ssd1306_mark_dirty(dev, page, 0, dev->_width);
+	}
+}
+
+// Clear one page of internal buffer. Not show it.
+void _ssd1306_clear_line(SSD1306_t * dev, int page, bool invert)
+{
+	if (page >= dev->_pages) return;
+	memset(dev->_page[page]._segs, invert ? 0xFF : 0x00, dev->_width);
+	ssd1306_mark_dirty(dev, page, 0, dev->_width);
+}
+
+static void ssd1306_send_contrast(SSD1306_t * dev, int contrast)
+{
+	ssd1306_bus_take(dev);
 	if (dev->_address == SPI_ADDRESS) {
 		spi_contrast(dev, contrast);
 	} else {
 		i2c_contrast(dev, contrast);
 	}
+	ssd1306_bus_give(dev);
+}
+
+void ssd1306_contrast(SSD1306_t * dev, int contrast)
+{
+	if (contrast < 0) contrast = 0;
+	if (contrast > 0xFF) contrast = 0xFF;
+	dev->_contrast = contrast;
+	ssd1306_send_contrast(dev, contrast);
 }
 
 void ssd1306_software_scroll(SSD1306_t * dev, int start, int end)
@@ -292,13 +785,6 @@ void ssd1306_scroll_text(SSD1306_t * dev, char * text, int text_len, bool invert
 	ESP_LOGD(TAG, "dev->_scEnable=%d", dev->_scEnable);
 	if (dev->_scEnable == false) return;
 
-	void (*func)(SSD1306_t * dev, int page, int seg, uint8_t * images, int width);
-	if (dev->_address == SPI_ADDRESS) {
-		func = spi_display_image;
-	} else {
-		func = i2c_display_image;
-	}
-
 	int srcIndex = dev->_scEnd - dev->_scDirection;
 	while(1) {
 		int dstIndex = srcIndex + dev->_scDirection;
@@ -306,7 +792,7 @@ void ssd1306_scroll_text(SSD1306_t * dev, char * text, int text_len, bool invert
 		for(int seg = 0; seg < dev->_width; seg++) {
 			dev->_page[dstIndex]._segs[seg] = dev->_page[srcIndex]._segs[seg];
 		}
-		(*func)(dev, dstIndex, 0, dev->_page[dstIndex]._segs, sizeof(dev->_page[dstIndex]._segs));
+		ssd1306_show_segs(dev, dstIndex, 0, sizeof(dev->_page[dstIndex]._segs));
 		if (srcIndex == dev->_scStart) break;
 		srcIndex = srcIndex - dev->_scDirection;
 	}
@@ -335,11 +821,13 @@ void ssd1306_scroll_clear(SSD1306_t * dev)
 
 void ssd1306_hardware_scroll(SSD1306_t * dev, ssd1306_scroll_type_t scroll)
 {
+	ssd1306_bus_take(dev);
 	if (dev->_address == SPI_ADDRESS) {
 		spi_hardware_scroll(dev, scroll);
 	} else {
 		i2c_hardware_scroll(dev, scroll);
 	}
+	ssd1306_bus_give(dev);
 }
 
 // delay = 0 : display with no wait
@@ -393,8 +881,6 @@ void ssd1306_wrap_arround(SSD1306_t * dev, ssd1306_scroll_type_t scroll, int sta
 			for (int seg=_start;seg<=_end;seg++) {
 				wk0 = dev->_page[page]._segs[seg];
 				wk1 = dev->_page[page+1]._segs[seg];
-				if (dev->_flip) wk0 = ssd1306_rotate_byte(wk0);
-				if (dev->_flip) wk1 = ssd1306_rotate_byte(wk1);
 				if (seg == 0) {
 					ESP_LOGD(TAG, "b page=%d wk0=%02x wk1=%02x", page, wk0, wk1);
 				}
@@ -405,7 +891,6 @@ void ssd1306_wrap_arround(SSD1306_t * dev, ssd1306_scroll_type_t scroll, int sta
 				if (seg == 0) {
 					ESP_LOGD(TAG, "a page=%d wk0=%02x wk1=%02x wk2=%02x", page, wk0, wk1, wk2);
 				}
-				if (dev->_flip) wk2 = ssd1306_rotate_byte(wk2);
 				dev->_page[page]._segs[seg] = wk2;
 			}
 		}
@@ -415,13 +900,10 @@ void ssd1306_wrap_arround(SSD1306_t * dev, ssd1306_scroll_type_t scroll, int sta
 		for (int seg=_start;seg<=_end;seg++) {
 			wk0 = dev->_page[pages]._segs[seg];
 			wk1 = save[seg];
-			if (dev->_flip) wk0 = ssd1306_rotate_byte(wk0);
-			if (dev->_flip) wk1 = ssd1306_rotate_byte(wk1);
 			wk0 = wk0 >> 1;
 			wk1 = wk1 & 0x01;
 			wk1 = wk1 << 7;
 			wk2 = wk0 | wk1;
-			if (dev->_flip) wk2 = ssd1306_rotate_byte(wk2);
 			dev->_page[pages]._segs[seg] = wk2;
 		}
 
@@ -444,8 +926,6 @@ void ssd1306_wrap_arround(SSD1306_t * dev, ssd1306_scroll_type_t scroll, int sta
 			for (int seg=_start;seg<=_end;seg++) {
 				wk0 = dev->_page[page]._segs[seg];
 				wk1 = dev->_page[page-1]._segs[seg];
-				if (dev->_flip) wk0 = ssd1306_rotate_byte(wk0);
-				if (dev->_flip) wk1 = ssd1306_rotate_byte(wk1);
 				if (seg == 0) {
 					ESP_LOGD(TAG, "b page=%d wk0=%02x wk1=%02x", page, wk0, wk1);
 				}
@@ -456,7 +936,6 @@ void ssd1306_wrap_arround(SSD1306_t * dev, ssd1306_scroll_type_t scroll, int sta
 				if (seg == 0) {
 					ESP_LOGD(TAG, "a page=%d wk0=%02x wk1=%02x wk2=%02x", page, wk0, wk1, wk2);
 				}
-				if (dev->_flip) wk2 = ssd1306_rotate_byte(wk2);
 				dev->_page[page]._segs[seg] = wk2;
 			}
 		}
@@ -465,13 +944,10 @@ void ssd1306_wrap_arround(SSD1306_t * dev, ssd1306_scroll_type_t scroll, int sta
 		for (int seg=_start;seg<=_end;seg++) {
 			wk0 = dev->_page[0]._segs[seg];
 			wk1 = save[seg];
-			if (dev->_flip) wk0 = ssd1306_rotate_byte(wk0);
-			if (dev->_flip) wk1 = ssd1306_rotate_byte(wk1);
 			wk0 = wk0 << 1;
 			wk1 = wk1 & 0x80;
 			wk1 = wk1 >> 7;
 			wk2 = wk0 | wk1;
-			if (dev->_flip) wk2 = ssd1306_rotate_byte(wk2);
 			dev->_page[0]._segs[seg] = wk2;
 		}
 
@@ -512,76 +988,366 @@ void ssd1306_wrap_arround(SSD1306_t * dev, ssd1306_scroll_type_t scroll, int sta
 
 	if (delay >= 0) {
 		for (int page=0;page<dev->_pages;page++) {
-			if (dev->_address == SPI_ADDRESS) {
-				spi_display_image(dev, page, 0, dev->_page[page]._segs, 128);
-			} else {
-				i2c_display_image(dev, page, 0, dev->_page[page]._segs, 128);
-			}
+			ssd1306_show_segs(dev, page, 0, 128);
 			if (delay) vTaskDelay(delay);
 		}
+		if (dev->_flushTask == NULL) ssd1306_clear_dirty(dev);
+	} else {
+		for (int page=0;page<dev->_pages;page++) {
+			ssd1306_mark_dirty(dev, page, 0, dev->_width);
+		}
+	}
+
+}
+
+// Combine one 8 pixel high band of columns, starting at pixel row ypos, into the internal buffer.
+// columns are LSB-top like a page byte; only bits in mask are drawn, and the band is clipped to the panel.
+static void ssd1306_blit_band(SSD1306_t * dev, int xpos, int ypos, const uint8_t * columns, int width, uint8_t mask, ssd1306_blit_mode_t mode, bool invert)
+{
+	int first = 0;
+	int last = width;
+	if (xpos < 0) first = -xpos;
+	if (xpos + last > dev->_width) last = dev->_width - xpos;
+	if (last <= first) return;
+
+	int page = (ypos >= 0) ? (ypos / 8) : -((7 - ypos) / 8);
+	int shift = ypos - page * 8;
+	uint8_t inv = invert ? mask : 0x00;
+
+	// The band straddles at most two pages: low bits go to page, high bits to page+1
+	for (int nn = 0; nn < 2; nn++, page++) {
+		if (page < 0 || page >= dev->_pages) continue;
+		int bits_shift = (nn == 0) ? shift : (shift - 8);
+		uint8_t _mask = (bits_shift >= 0) ? (mask << bits_shift) : (mask >> -bits_shift);
+		if (_mask == 0) continue;
+
+		uint8_t * dst = &dev->_page[page]._segs[xpos];
+		for (int xx = first; xx < last; xx++) {
+			uint8_t src = (columns[xx] & mask) ^ inv;
+			uint8_t _bits = (bits_shift >= 0) ? (src << bits_shift) : (src >> -bits_shift);
+			uint8_t wk = dst[xx];
+			switch (mode) {
+			case BLIT_COPY:
+				wk = (wk & ~_mask) | _bits;
+				break;
+			case BLIT_OR:
+				wk = wk | _bits;
+				break;
+			case BLIT_AND_NOT:
+				wk = wk & ~_bits;
+				break;
+			case BLIT_XOR:
+				wk = wk ^ _bits;
+				break;
+			}
+			dst[xx] = wk;
+		}
+	}
+}
+
+static void ssd1306_blit_mark_dirty(SSD1306_t * dev, int xpos, int ypos, int width, int height)
+{
+	if (ypos + height <= 0) return;
+	int first = (ypos < 0) ? 0 : ypos / 8;
+	int last = (ypos + height - 1) / 8;
+	for (int page = first; page <= last; page++) {
+		ssd1306_mark_dirty(dev, page, xpos, width);
+	}
+}
+
+// Transpose an 8x8 bit block: byte r bit b becomes byte b bit r
+static uint64_t ssd1306_transpose8(uint64_t x)
+{
+	uint64_t t;
+	t = 0x0F0F0F0F00000000ULL & (x ^ (x << 28));
+	x ^= t ^ (t >> 28);
+	t = 0x3333000033330000ULL & (x ^ (x << 14));
+	x ^= t ^ (t >> 14);
+	t = 0x5500550055005500ULL & (x ^ (x << 7));
+	x ^= t ^ (t >> 7);
+	return x;
+}
+
+// Blit a row-major bitmap (MSB is the leftmost pixel, rows padded to whole bytes) into internal buffer.
+// Each 8x8 block is transposed to page bytes, so no pixel is handled on its own. Not show it.
+void _ssd1306_blit(SSD1306_t * dev, int xpos, int ypos, const uint8_t * bitmap, int width, int height, ssd1306_blit_mode_t mode, bool invert)
+{
+	int _width = (width + 7) / 8;
+	for (int yy = 0; yy < height; yy = yy + 8) {
+		int rows = height - yy;
+		if (rows > 8) rows = 8;
+		uint8_t mask = (rows == 8) ? 0xFF : ((1 << rows) - 1);
+		for (int index = 0; index < _width; index++) {
+			uint64_t block = 0;
+			for (int row = 0; row < rows; row++) {
+				block |= (uint64_t)bitmap[(yy + row) * _width + index] << (row * 8);
+			}
+			block = ssd1306_transpose8(block);
+			uint8_t columns[8];
+			for (int xx = 0; xx < 8; xx++) {
+				columns[xx] = (block >> ((7 - xx) * 8)) & 0xFF;
+			}
+			int cols = width - index * 8;
+			if (cols > 8) cols = 8;
+			ssd1306_blit_band(dev, xpos + index * 8, ypos + yy, columns, cols, mask, mode, invert);
+		}
 	}
+	ssd1306_blit_mark_dirty(dev, xpos, ypos, width, height);
+}
 
+// Blit a bitmap laid out like the panel (height/8 rows of width column bytes, LSB top) into internal buffer.
+// Not show it.
+void _ssd1306_blit_columns(SSD1306_t * dev, int xpos, int ypos, const uint8_t * columns, int width, int height, ssd1306_blit_mode_t mode, bool invert)
+{
+	for (int yy = 0; yy < height; yy = yy + 8) {
+		int rows = height - yy;
+		if (rows > 8) rows = 8;
+		uint8_t mask = (rows == 8) ? 0xFF : ((1 << rows) - 1);
+		ssd1306_blit_band(dev, xpos, ypos + yy, &columns[(yy / 8) * width], width, mask, mode, invert);
+	}
+	ssd1306_blit_mark_dirty(dev, xpos, ypos, width, height);
 }
 
+// Copy a row-major bitmap into internal buffer. Not show it.
 void _ssd1306_bitmaps(SSD1306_t * dev, int xpos, int ypos, uint8_t * bitmap, int width, int height, bool invert)
 {
-	if ( (width % 8) != 0) {
-		ESP_LOGE(TAG, "width must be a multiple of 8");
+	_ssd1306_blit(dev, xpos, ypos, bitmap, width, height, BLIT_COPY, invert);
+}
+
+
+void ssd1306_bitmaps(SSD1306_t * dev, int xpos, int ypos, uint8_t * bitmap, int width, int height, bool invert)
+{
+	_ssd1306_bitmaps(dev, xpos, ypos, bitmap, width, height, invert);
+	ssd1306_show_buffer(dev);
+}
+
+// Copy an icon into internal buffer. Not show it.
+// At a page aligned ypos each page of the icon is a single memcpy.
+void _ssd1306_draw_icon(SSD1306_t * dev, const ssd1306_icon_t * icon, int xpos, int ypos, bool invert)
+{
+	if (invert || ypos % 8 != 0 || xpos < 0 || ypos < 0) {
+		_ssd1306_blit_columns(dev, xpos, ypos, icon->columns, icon->width, icon->height, BLIT_COPY, invert);
 		return;
 	}
-	int _width = width / 8;
-	uint8_t wk0;
-	uint8_t wk1;
-	uint8_t wk2;
-	uint8_t page = (ypos / 8);
-	uint8_t _seg = xpos;
-	uint8_t dstBits = (ypos % 8);
-	ESP_LOGD(TAG, "_width=%d ypos=%d page=%d dstBits=%d", _width, ypos, page, dstBits);
-	int offset = 0;
-	for(int _height=0;_height<height;_height++) {
-		for (int index=0;index<_width;index++) {
-			for (int srcBits=7; srcBits>=0; srcBits--) {
-				wk0 = dev->_page[page]._segs[_seg];
-				if (dev->_flip) wk0 = ssd1306_rotate_byte(wk0);
-
-				wk1 = bitmap[index+offset];
-				if (invert) wk1 = ~wk1;
-
-				//wk2 = ssd1306_copy_bit(bitmap[index+offset], srcBits, wk0, dstBits);
-				wk2 = ssd1306_copy_bit(wk1, srcBits, wk0, dstBits);
-				if (dev->_flip) wk2 = ssd1306_rotate_byte(wk2);
-
-				ESP_LOGD(TAG, "index=%d offset=%d wk1=0x%x page=%d _seg=%d, wk2=%02x", index, offset, wk1, page, _seg, wk2);
-				dev->_page[page]._segs[_seg] = wk2;
-				_seg++;
+	int width = icon->width;
+	if (xpos >= dev->_width) return;
+	if (width > dev->_width - xpos) width = dev->_width - xpos;
+	int pages = (icon->height + 7) / 8;
+	for (int index = 0; index < pages; index++) {
+		int page = ypos / 8 + index;
+		if (page >= dev->_pages) break;
+		const uint8_t * src = &icon->columns[index * icon->width];
+		int rows = icon->height - index * 8;
+		if (rows < 8) {
+			// Keep the pixels below a partial last page
+			uint8_t mask = (1 << rows) - 1;
+			uint8_t * dst = &dev->_page[page]._segs[xpos];
+			for (int seg = 0; seg < width; seg++) {
+				dst[seg] = (dst[seg] & ~mask) | (src[seg] & mask);
 			}
+		} else {
+			memcpy(&dev->_page[page]._segs[xpos], src, width);
 		}
-		vTaskDelay(1);
-		offset = offset + _width;
-		dstBits++;
-		_seg = xpos;
-		if (dstBits == 8) {
-			page++;
-			dstBits=0;
+		ssd1306_mark_dirty(dev, page, xpos, width);
+	}
+}
+
+// O(1) lookup into the glyph index. Returns NULL for code points the font does not cover.
+static const ssd1306_glyph_t * ssd1306_font_glyph(const ssd1306_font_t * font, uint32_t code)
+{
+	if (code >= font->first && code <= font->last) {
+		return &font->glyphs[code - font->first];
+	}
+	if (font->ext_index != NULL && code >= font->ext_first && code <= font->ext_last) {
+		uint8_t position = font->ext_index[code - font->ext_first];
+		if (position != 0) return &font->glyphs[position];
+	}
+	return NULL;
+}
+
+// Decode the UTF-8 sequence at text[*index] and advance *index past it.
+// Malformed or truncated sequences decode to 0xFFFD, which no font covers.
+static uint32_t ssd1306_utf8_next(char * text, int text_len, int * index)
+{
+	uint8_t ch = text[(*index)++];
+	if (ch < 0x80) return ch;
+
+	int follow;
+	uint32_t code;
+	if ((ch & 0xE0) == 0xC0) {
+		follow = 1;
+		code = ch & 0x1F;
+	} else if ((ch & 0xF0) == 0xE0) {
+		follow = 2;
+		code = ch & 0x0F;
+	} else if ((ch & 0xF8) == 0xF0) {
+		follow = 3;
+		code = ch & 0x07;
+	} else {
+		return 0xFFFD;
+	}
+	for (int nn = 0; nn < follow; nn++) {
+		if (*index >= text_len) return 0xFFFD;
+		ch = text[*index];
+		if ((ch & 0xC0) != 0x80) return 0xFFFD;
+		code = (code << 6) | (ch & 0x3F);
+		(*index)++;
+	}
+	return code;
+}
+
+// Unpack the bit-packed columns of a glyph into page rows of glyph->width bytes each
+static void ssd1306_font_unpack(const ssd1306_font_t * font, const ssd1306_glyph_t * glyph, uint8_t * columns)
+{
+	const uint8_t * src = &font->bitmap[glyph->offset];
+	int pages = (font->height + 7) / 8;
+	if ((font->height % 8) == 0) {
+		// Columns are whole bytes, so only the order changes
+		for (int xx = 0; xx < glyph->width; xx++) {
+			for (int page = 0; page < pages; page++) {
+				columns[page * glyph->width + xx] = *src++;
+			}
 		}
+		return;
 	}
 
-#if 0
-	for (int _seg=ypos;_seg<ypos+width;_seg++) {
-		ssd1306_dump_page(dev, page-1, _seg);
+	memset(columns, 0, pages * glyph->width);
+	int bit = 0;
+	for (int xx = 0; xx < glyph->width; xx++) {
+		for (int yy = 0; yy < font->height; yy++, bit++) {
+			if (src[bit / 8] & (1 << (bit % 8))) {
+				columns[(yy / 8) * glyph->width + xx] |= 1 << (yy % 8);
+			}
+		}
 	}
-	for (int _seg=ypos;_seg<ypos+width;_seg++) {
-		ssd1306_dump_page(dev, page, _seg);
+}
+
+// Width in pixels of UTF-8 text drawn with font
+int ssd1306_text_width(const ssd1306_font_t * font, char * text, int text_len)
+{
+	int width = 0;
+	int index = 0;
+	while (index < text_len) {
+		const ssd1306_glyph_t * glyph = ssd1306_font_glyph(font, ssd1306_utf8_next(text, text_len, &index));
+		if (glyph != NULL) width = width + glyph->advance;
 	}
-#endif
-	//ssd1306_show_buffer(dev);
+	return width;
 }
 
+// Draw proportional UTF-8 text with its top left corner at xpos/ypos into internal buffer. Not show it.
+// text_len is in bytes; code points the font lacks are skipped.
+// Returns the x position after the last glyph.
+int _ssd1306_draw_text(SSD1306_t * dev, const ssd1306_font_t * font, int xpos, int ypos, char * text, int text_len, ssd1306_blit_mode_t mode)
+{
+	if (font->height > SSD1306_FONT_MAX_HEIGHT) return xpos;
+	uint8_t columns[(SSD1306_FONT_MAX_HEIGHT / 8) * SSD1306_FONT_MAX_WIDTH];
+	int _xpos = xpos;
+	int index = 0;
+	while (index < text_len) {
+		if (_xpos >= dev->_width) break;
+		const ssd1306_glyph_t * glyph = ssd1306_font_glyph(font, ssd1306_utf8_next(text, text_len, &index));
+		if (glyph == NULL) continue;
+		if (glyph->width > 0 && glyph->width <= SSD1306_FONT_MAX_WIDTH) {
+			ssd1306_font_unpack(font, glyph, columns);
+			_ssd1306_blit_columns(dev, _xpos + glyph->xoffset, ypos, columns, glyph->width, font->height, mode, false);
+		}
+		_xpos = _xpos + glyph->advance;
+	}
+	return _xpos;
+}
 
-void ssd1306_bitmaps(SSD1306_t * dev, int xpos, int ypos, uint8_t * bitmap, int width, int height, bool invert)
+int ssd1306_draw_text(SSD1306_t * dev, const ssd1306_font_t * font, int xpos, int ypos, char * text, int text_len, ssd1306_blit_mode_t mode)
 {
-	_ssd1306_bitmaps(dev, xpos, ypos, bitmap, width, height, invert);
+	int _xpos = _ssd1306_draw_text(dev, font, xpos, ypos, text, text_len, mode);
 	ssd1306_show_buffer(dev);
+	return _xpos;
+}
+
+// Render text once into an off-screen strip for ssd1306_marquee_step.
+// The SH1106 has no horizontal scroll command, so scrolling copies a window of the strip
+// into the buffer and only that span goes on the bus; nothing is re-rendered per step.
+// marquee must be zeroed or set up by an earlier call, whose strip is reused when it is large enough.
+bool ssd1306_marquee_init(SSD1306_t * dev, ssd1306_marquee_t * marquee, const ssd1306_font_t * font, int page, int seg, int window, char * text, int text_len)
+{
+	uint8_t * strip = marquee->strip;
+	int size = marquee->size;
+	memset(marquee, 0, sizeof(ssd1306_marquee_t));
+	marquee->strip = strip;
+	marquee->size = size;
+	if (page < 0 || page >= dev->_pages) return false;
+	if (seg < 0 || seg >= dev->_width) return false;
+	if (window <= 0) return false;
+	if (seg + window > dev->_width) window = dev->_width - seg;
+
+	int pages = (font->height + 7) / 8;
+	if (page + pages > dev->_pages) pages = dev->_pages - page;
+	int text_width = ssd1306_text_width(font, text, text_len);
+	// Text that fits is drawn once and never scrolls; otherwise leave a gap before it repeats
+	int width = (text_width > window) ? (text_width + SSD1306_MARQUEE_GAP) : window;
+
+	if (pages * width > marquee->size) {
+		ssd1306_marquee_free(marquee);
+		marquee->strip = ssd1306_alloc(dev, pages * width, MALLOC_CAP_8BIT);
+		if (marquee->strip == NULL) {
+			ESP_LOGE(TAG, "marquee strip alloc fail");
+			return false;
+		}
+		marquee->size = pages * width;
+	}
+	memset(marquee->strip, 0, pages * width);
+	marquee->width = width;
+	marquee->pages = pages;
+	marquee->page = page;
+	marquee->seg = seg;
+	marquee->window = window;
+	marquee->offset = 0;
+
+	uint8_t columns[(SSD1306_FONT_MAX_HEIGHT / 8) * SSD1306_FONT_MAX_WIDTH];
+	int xpos = 0;
+	int index = 0;
+	while (index < text_len) {
+		const ssd1306_glyph_t * glyph = ssd1306_font_glyph(font, ssd1306_utf8_next(text, text_len, &index));
+		if (glyph == NULL) continue;
+		if (glyph->width > 0 && glyph->width <= SSD1306_FONT_MAX_WIDTH) {
+			ssd1306_font_unpack(font, glyph, columns);
+			for (int xx = 0; xx < glyph->width; xx++) {
+				int _xpos = xpos + glyph->xoffset + xx;
+				if (_xpos < 0 || _xpos >= width) continue;
+				for (int _page = 0; _page < pages; _page++) {
+					marquee->strip[_page * width + _xpos] |= columns[_page * glyph->width + xx];
+				}
+			}
+		}
+		xpos = xpos + glyph->advance;
+	}
+	return true;
+}
+
+// Advance the marquee by step columns, negative scrolls back, and copy its window into internal buffer. Not show it.
+void _ssd1306_marquee_step(SSD1306_t * dev, ssd1306_marquee_t * marquee, int step)
+{
+	if (marquee->strip == NULL) return;
+	if (marquee->width > marquee->window) {
+		marquee->offset = ((marquee->offset + step) % marquee->width + marquee->width) % marquee->width;
+	}
+
+	for (int _page = 0; _page < marquee->pages; _page++) {
+		uint8_t * src = &marquee->strip[_page * marquee->width];
+		uint8_t * dst = &dev->_page[marquee->page + _page]._segs[marquee->seg];
+		// The window may wrap around the end of the strip
+		int first = marquee->width - marquee->offset;
+		if (first > marquee->window) first = marquee->window;
+		memcpy(dst, &src[marquee->offset], first);
+		memcpy(&dst[first], src, marquee->window - first);
+		ssd1306_mark_dirty(dev, marquee->page + _page, marquee->seg, marquee->window);
+	}
+}
+
+void ssd1306_marquee_free(ssd1306_marquee_t * marquee)
+{
+	heap_caps_free(marquee->strip);
+	marquee->strip = NULL;
+	marquee->size = 0;
 }
 
 
@@ -599,9 +1365,9 @@ void _ssd1306_pixel(SSD1306_t * dev, int xpos, int ypos, bool invert)
 	} else {
 		wk0 = wk0 | wk1;
 	}
-	if (dev->_flip) wk0 = ssd1306_rotate_byte(wk0);
 	ESP_LOGD(TAG, "wk0=0x%02x wk1=0x%02x", wk0, wk1);
 	dev->_page[_page]._segs[_seg] = wk0;
+	ssd1306_mark_dirty(dev, _page, _seg, 1);
 }
 
 // Set line to internal buffer. Not show it.
@@ -717,39 +1483,232 @@ uint8_t ssd1306_copy_bit(uint8_t src, int srcBits, uint8_t dst, int dstBits)
 // Rotate 8-bit data
 // 0x12-->0x48
 uint8_t ssd1306_rotate_byte(uint8_t ch1) {
-	uint8_t ch2 = 0;
-	for (int j=0;j<8;j++) {
-		ch2 = (ch2 << 1) + (ch1 & 0x01);
-		ch1 = ch1 >> 1;
-	}
-	return ch2;
+	return ssd1306_bit_reverse[ch1];
 }
 
 
+// Fade the panel to black and clear it.
+// A contrast ramp costs one command per frame instead of a write per segment.
 void ssd1306_fadeout(SSD1306_t * dev)
 {
-	void (*func)(SSD1306_t * dev, int page, int seg, uint8_t * images, int width);
-	if (dev->_address == SPI_ADDRESS) {
-		func = spi_display_image;
-	} else {
-		func = i2c_display_image;
+	ssd1306_animate(dev, ANIM_FADE_OUT, 400);
+}
+
+// Capture what the panel shows as the source of the next ssd1306_animate.
+// Call it before drawing the next screen into the buffer. Spans drawn but not shown yet are
+// flushed first, since ssd1306_animate takes the panel to match the captured frame.
+bool ssd1306_anim_begin(SSD1306_t * dev)
+{
+	if (dev->_anim == NULL) return false;
+	for (int page=0; page<dev->_pages; page++) {
+		if (dev->_dirtyEnd[page] >= dev->_dirtyStart[page]) {
+			ssd1306_show_buffer(dev);
+			break;
+		}
 	}
+	ssd1306_flush_wait(dev);
+	// The buffer now matches the panel
+	memcpy(dev->_anim, dev->_fb, SSD1306_FB_LEN);
+	dev->_animReady = true;
+	return true;
+}
 
-	uint8_t image[1];
-	for(int page=0; page<dev->_pages; page++) {
-		image[0] = 0xFF;
-		for(int line=0; line<8; line++) {
-			if (dev->_flip) {
-				image[0] = image[0] >> 1;
-			} else {
-				image[0] = image[0] << 1;
+// Smoothstep of step/steps scaled to range, so transitions ease in and out
+static int ssd1306_anim_ease(int step, int steps, int range)
+{
+	int64_t s = (int64_t)step * step * (3 * steps - 2 * step);
+	return (int)(s * range / ((int64_t)steps * steps * steps));
+}
+
+// Compose frame step of a slide or wipe from the source (from) and target (to) frames
+static void ssd1306_anim_render(SSD1306_t * dev, ssd1306_anim_type_t type, PAGE_t * from, PAGE_t * to, int step, int steps)
+{
+	int width = dev->_width;
+	int height = dev->_pages * 8;
+	int offset = ssd1306_anim_ease(step, steps, (type == ANIM_WIPE_DOWN || type == ANIM_WIPE_UP) ? height : width);
+	uint32_t words[128 / 4]; // Word aligned for ssd1306_store_page
+	uint8_t * row = (uint8_t *)words;
+	for (int page=0; page<dev->_pages; page++) {
+		const uint8_t * src = from[page]._segs;
+		const uint8_t * dst = to[page]._segs;
+		switch (type) {
+		case ANIM_SLIDE_LEFT:
+			memcpy(row, &src[offset], width - offset);
+			memcpy(&row[width - offset], dst, offset);
+			break;
+		case ANIM_SLIDE_RIGHT:
+			memcpy(row, &dst[width - offset], offset);
+			memcpy(&row[offset], src, width - offset);
+			break;
+		case ANIM_WIPE_LEFT:
+			memcpy(row, src, width - offset);
+			memcpy(&row[width - offset], &dst[width - offset], offset);
+			break;
+		case ANIM_WIPE_RIGHT:
+			memcpy(row, dst, offset);
+			memcpy(&row[offset], &src[offset], width - offset);
+			break;
+		default: {
+			// Rows above offset (down) or from height - offset (up) show the target
+			int first = (type == ANIM_WIPE_DOWN) ? 0 : height - offset;
+			int last = (type == ANIM_WIPE_DOWN) ? offset : height;
+			uint8_t mask = 0;
+			for (int bit=0; bit<8; bit++) {
+				int y = page * 8 + bit;
+				if (y >= first && y < last) mask |= 1 << bit;
+			}
+			for (int seg=0; seg<width; seg++) {
+				row[seg] = (dst[seg] & mask) | (src[seg] & ~mask);
 			}
-			for(int seg=0; seg<128; seg++) {
-				(*func)(dev, page, seg, image, 1);
-				dev->_page[page]._segs[seg] = image[0];
+			break;
+		}
+		}
+		ssd1306_store_page(dev, page, words);
+	}
+}
+
+// Contrast of a fade at level of levels, relative to the contrast set by ssd1306_contrast.
+// Brightness follows the square of the level, which looks even to the eye.
+static void ssd1306_anim_contrast(SSD1306_t * dev, int level, int levels)
+{
+	ssd1306_send_contrast(dev, dev->_contrast * level * level / (levels * levels));
+}
+
+// Show frame step of the running transition; prev is the frame shown before it.
+// Frames are only ever shown in order, but ssd1306_anim_finish may skip to the last one.
+static void ssd1306_anim_frame(SSD1306_t * dev, int prev, int step)
+{
+	int steps = dev->_animSteps;
+	switch (dev->_animType) {
+	case ANIM_FADE: {
+		// Ramp down over the first half, swap the frame in the dark, ramp up over the second
+		int half = steps / 2;
+		if (prev < half && step >= half) {
+			ssd1306_send_contrast(dev, 0);
+			ssd1306_show_buffer(dev);
+			// The new frame must be on the panel before the contrast comes back
+			ssd1306_flush_wait(dev);
+		}
+		if (step < half) {
+			ssd1306_anim_contrast(dev, half - step, half);
+		} else if (step > half) {
+			ssd1306_anim_contrast(dev, step - half, half);
+		}
+		break;
+	}
+	case ANIM_FADE_IN:
+		ssd1306_anim_contrast(dev, step, steps);
+		break;
+	case ANIM_FADE_OUT:
+		if (step < steps) {
+			ssd1306_anim_contrast(dev, steps - step, steps);
+			break;
+		}
+		ssd1306_send_contrast(dev, 0);
+		_ssd1306_clear_screen(dev, false);
+		ssd1306_show_buffer(dev);
+		ssd1306_flush_wait(dev);
+		ssd1306_send_contrast(dev, dev->_contrast);
+		break;
+	default:
+		ssd1306_anim_render(dev, dev->_animType, dev->_anim, &dev->_anim[8], step, steps);
+		ssd1306_show_buffer(dev);
+		break;
+	}
+}
+
+// Start a transition from the frame captured by ssd1306_anim_begin to the buffer contents,
+// and show its first frame. Nothing waits here: the caller shows the next frames with
+// ssd1306_anim_step, e.g. from its own loop, so a transition never blocks a task.
+// Frames are rendered into the buffer and flushed once per SSD1306_ANIM_FPS tick, so a
+// transition costs at most one flush, or one contrast command, per frame. Nothing else may
+// draw into the buffer until the transition has ended.
+// Without ssd1306_anim_begin, slides and wipes start from a blank screen.
+// Returns the ticks until the next frame is due, 0 when the transition is over already.
+TickType_t ssd1306_anim_start(SSD1306_t * dev, ssd1306_anim_type_t type, int duration_ms)
+{
+	ssd1306_anim_finish(dev);
+	TickType_t period = pdMS_TO_TICKS(1000 / SSD1306_ANIM_FPS);
+	if (period == 0) period = 1;
+	int steps = pdMS_TO_TICKS(duration_ms) / period;
+	if (steps < 1) steps = 1;
+	bool ready = dev->_animReady;
+	dev->_animReady = false;
+
+	if (type == ANIM_FADE) {
+		steps = ((steps + 1) / 2) * 2;
+	} else if (type == ANIM_FADE_IN) {
+		ssd1306_send_contrast(dev, 0);
+		ssd1306_show_buffer(dev);
+		ssd1306_flush_wait(dev);
+	} else if (type != ANIM_FADE_OUT) {
+		if (dev->_anim == NULL) {
+			ssd1306_show_buffer(dev);
+			return 0;
+		}
+		PAGE_t * from = dev->_anim;
+		PAGE_t * to = &dev->_anim[8];
+		if (!ready) {
+			memset(from, 0, SSD1306_FB_LEN);
+		}
+		memcpy(to, dev->_fb, SSD1306_FB_LEN);
+		// The buffer now tracks the frames on the panel, starting from the source
+		memcpy(dev->_fb, from, SSD1306_FB_LEN);
+		ssd1306_clear_dirty(dev);
+		if (!ready) {
+			// The panel content is unknown, so the first frame is sent in full
+			for (int page=0; page<dev->_pages; page++) {
+				ssd1306_mark_dirty(dev, page, 0, dev->_width);
 			}
 		}
 	}
+
+	dev->_animType = type;
+	dev->_animStep = 0;
+	dev->_animSteps = steps;
+	dev->_animPeriod = period;
+	dev->_animWake = xTaskGetTickCount();
+	return ssd1306_anim_step(dev);
+}
+
+// Show the next frame of the running transition when it is due.
+// Returns the ticks until the frame after it is due, 0 once the last frame is shown.
+TickType_t ssd1306_anim_step(SSD1306_t * dev)
+{
+	if (dev->_animSteps == 0) return 0;
+	TickType_t now = xTaskGetTickCount();
+	if ((int32_t)(dev->_animWake - now) > 0) return dev->_animWake - now;
+
+	int prev = dev->_animStep;
+	dev->_animStep++;
+	ssd1306_anim_frame(dev, prev, dev->_animStep);
+	if (dev->_animStep >= dev->_animSteps) {
+		dev->_animSteps = 0;
+		return 0;
+	}
+	dev->_animWake += dev->_animPeriod;
+	now = xTaskGetTickCount();
+	// A late caller gets the next frame right away, so frames are never skipped
+	if ((int32_t)(dev->_animWake - now) <= 0) return 1;
+	return dev->_animWake - now;
+}
+
+// End the running transition at once on its last frame, e.g. before drawing something else
+void ssd1306_anim_finish(SSD1306_t * dev)
+{
+	if (dev->_animSteps == 0) return;
+	ssd1306_anim_frame(dev, dev->_animStep, dev->_animSteps);
+	dev->_animSteps = 0;
+}
+
+// Run a whole transition, see ssd1306_anim_start. Blocks the caller until it has ended.
+void ssd1306_animate(SSD1306_t * dev, ssd1306_anim_type_t type, int duration_ms)
+{
+	TickType_t wait = ssd1306_anim_start(dev, type, duration_ms);
+	while (wait != 0) {
+		vTaskDelay(wait);
+		wait = ssd1306_anim_step(dev);
+	}
 }
 
 // Rotate character image
@@ -789,7 +1748,7 @@ void ssd1306_display_rotate_text(SSD1306_t * dev, int seg, char * text, int text
 	int _page = dev->_pages-1;
 	for (uint8_t i = 0; i < _text_len; i++) {
 		memcpy(image, font8x8_basic_tr[(uint8_t)text[i]], 8);
-		ssd1306_rotate_image(image, dev->_flip);
+		ssd1306_rotate_image(image, false);
 		ESP_LOGD(TAG, "_page=%d seg=%d", _page, seg);
 		if (invert) ssd1306_invert(image, 8);
 		ssd1306_display_image(dev, _page, seg, image, 8);
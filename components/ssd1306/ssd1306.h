@@ -1,12 +1,20 @@
 #ifndef MAIN_SSD1306_H_
 #define MAIN_SSD1306_H_
 
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_err.h"
+#if !CONFIG_IDF_TARGET_LINUX
 #include "driver/spi_master.h"
 #if (ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 2, 0))
 #include "driver/i2c_master.h"
 #else
 #include "driver/i2c.h"
 #endif
+#endif
+
+#include "ssd1306_font.h"
 
 // Following definitions are bollowed from 
 // http://robotcantalk.blogspot.com/2015/03/interfacing-arduino-with-ssd1306-driven.html
@@ -76,6 +84,12 @@ Usage:
 #define I2C_ADDRESS 0x3C
 #define SPI_ADDRESS 0xFF
 
+#define SSD1306_FB_LEN (128 * 8) // Bytes of a full frame
+#define SSD1306_TX_BUF_LEN (SSD1306_FB_LEN + 24) // One full frame plus control and addressing bytes
+#define SSD1306_TEXT_SCALE_MAX 4 // Largest scale of ssd1306_display_text_scaled
+#define SSD1306_MARQUEE_GAP 24 // Blank columns between repeats of a marquee
+#define SSD1306_ANIM_FPS 25 // Frame rate of transitions, see ssd1306_anim_start
+
 typedef enum {
 	SCROLL_RIGHT = 1,
 	SCROLL_LEFT = 2,
@@ -86,9 +100,69 @@ typedef enum {
 	SCROLL_STOP = 7
 } ssd1306_scroll_type_t;
 
+typedef enum {
+	CONTROLLER_SSD1306 = 0,
+	CONTROLLER_SH1106 = 1
+} ssd1306_controller_t;
+
+typedef enum {
+	BLIT_COPY = 0,		// Replace the covered pixels
+	BLIT_OR = 1,		// Set pixels that are set in the bitmap
+	BLIT_AND_NOT = 2,	// Clear pixels that are set in the bitmap
+	BLIT_XOR = 3		// Toggle pixels that are set in the bitmap
+} ssd1306_blit_mode_t;
+
+// Bitmap in the panel's layout: one row of width bytes per page, bit 0 at the top.
+// Atlases of these are generated by tools/iconconv.py.
+typedef struct {
+	uint8_t width;
+	uint8_t height;
+	const uint8_t * columns;	// (height + 7) / 8 rows of width bytes
+} ssd1306_icon_t;
+
+typedef enum {
+	ANIM_FADE = 0,			// Contrast ramp down, new frame, ramp back up
+	ANIM_FADE_IN = 1,		// New frame shown at contrast 0, ramp up
+	ANIM_FADE_OUT = 2,		// Ramp down, then the screen and buffer are cleared
+	ANIM_SLIDE_LEFT = 3,	// New frame pushes the old one out to the left
+	ANIM_SLIDE_RIGHT = 4,	// New frame pushes the old one out to the right
+	ANIM_WIPE_LEFT = 5,		// New frame uncovered from the right edge
+	ANIM_WIPE_RIGHT = 6,	// New frame uncovered from the left edge
+	ANIM_WIPE_DOWN = 7,		// New frame uncovered from the top
+	ANIM_WIPE_UP = 8		// New frame uncovered from the bottom
+} ssd1306_anim_type_t;
+
+typedef struct {
+	uint8_t * strip;	// Rendered text, pages rows of width columns
+	int width;			// Columns in strip, text plus gap
+	int pages;			// Pages covered by the marquee
+	int page;			// First page on the panel
+	int seg;			// First column of the window on the panel
+	int window;			// Columns visible on the panel
+	int offset;			// Column of strip shown at seg
+	int size;			// Bytes allocated for strip
+} ssd1306_marquee_t;
+
+// Bus usage counters, see ssd1306_get_bus_stats().
+// Command bytes are everything on the wire that is not GDDRAM data:
+// I2C address and control bytes, addressing and configuration commands.
+typedef struct {
+	uint32_t transactions;	// I2C START..STOP sequences or SPI transactions
+	uint32_t payload_bytes;	// GDDRAM data bytes
+	uint32_t command_bytes;	// Address, control and command bytes
+	uint32_t errors;		// Transactions the bus driver reported as failed
+	uint32_t flushes;		// Buffer or frame flushes
+	uint64_t tx_time_us;	// Time spent holding the bus, all writes included
+	uint32_t last_flush_us;	// Bus time of the latest flush
+	uint32_t max_flush_us;	// Longest flush
+} ssd1306_bus_stats_t;
+
+// One I2C write transaction to the panel, see i2c_shared_add().
+// Lets a bus manager that owns the port arbitrate the panel against other devices.
+typedef esp_err_t (*ssd1306_i2c_write_t)(void * ctx, const uint8_t * buf, size_t len);
+
+// One page of the framebuffer: 8 pixel rows, one byte per segment, bit 0 at the top
 typedef struct {
-	bool _valid; // Not using it anymore
-	int _segLen; // Not using it anymore
 	uint8_t _segs[128];
 } PAGE_t;
 
@@ -102,13 +176,48 @@ typedef struct {
 	int _scStart;
 	int _scEnd;
 	int _scDirection;
-	PAGE_t _page[8];
-	bool _flip;
+	// The framebuffer is one word aligned block, page after page, so a frame can go out
+	// in a single transfer and be cleared or compared a word at a time.
+	// It is DMA capable as long as SSD1306_t is in internal RAM (static, or MALLOC_CAP_DMA).
+	union {
+		uint8_t _fb[SSD1306_FB_LEN];
+		uint32_t _fbWords[SSD1306_FB_LEN / 4];
+		PAGE_t _page[8]; // Page views into _fb
+	};
+	int _dirtyStart[8]; // First segment of each page that differs from the panel
+	int _dirtyEnd[8]; // Last segment of each page that differs from the panel. Clean when _dirtyEnd < _dirtyStart
+	bool _flip; // Panel mounted upside down. Applied by the transports, the buffer stays upright
+	ssd1306_controller_t _controller;
+	bool _horizontal; // Panel is in horizontal addressing mode after a full frame flush
+	PAGE_t * _front; // Front buffer sent by the flush task. _page is the back buffer drawn into
+	int _frontDirtyStart[8];
+	int _frontDirtyEnd[8];
+	SemaphoreHandle_t _frontLock; // Guards _front and its dirty ranges. Only held while copying
+	SemaphoreHandle_t _busLock; // Serializes use of _tx_buf and the addressing mode
+	TaskHandle_t _flushTask;
+	uint32_t _swapCount; // Swaps handed to the flush task, guarded by _frontLock
+	volatile uint32_t _flushedCount; // _swapCount of the latest swap on the panel
+	int _contrast; // Contrast set by ssd1306_contrast, restored after fades
+	PAGE_t * _anim; // Source and target frame of transitions, allocated by ssd1306_init
+	bool _animReady; // ssd1306_anim_begin captured the source frame
+	ssd1306_anim_type_t _animType; // Running transition, see ssd1306_anim_start
+	int _animStep; // Frames of it shown so far
+	int _animSteps; // Frames in total, 0 when no transition runs
+	TickType_t _animPeriod; // Ticks between frames
+	TickType_t _animWake; // Tick the next frame is due
+	uint8_t * _tx_buf; // DMA capable transmit buffer, allocated once by ssd1306_init
+	uint32_t _allocs; // Heap allocations made through ssd1306_alloc
+	ssd1306_bus_stats_t _stats; // Updated while holding _busLock
+	int64_t _busTakenAt; // esp_timer time _busLock was taken
+	ssd1306_i2c_write_t _i2cWrite; // Set by i2c_shared_add, the I2C transports write through it instead of the driver
+	void * _i2cCtx; // Passed to _i2cWrite
+#if !CONFIG_IDF_TARGET_LINUX
 	i2c_port_t _i2c_num;
 	spi_device_handle_t _spi_device_handle;
 #if (ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 2, 0))
 	i2c_master_dev_handle_t _i2c_dev_handle;
 #endif
+#endif
 } SSD1306_t;
 
 #ifdef __cplusplus
@@ -117,10 +226,25 @@ extern "C"
 #endif
 
 void ssd1306_init(SSD1306_t * dev, int width, int height);
+void * ssd1306_alloc(SSD1306_t * dev, size_t size, uint32_t caps);
+uint32_t ssd1306_get_allocs(SSD1306_t * dev);
+void ssd1306_reinit(SSD1306_t * dev);
 int ssd1306_get_width(SSD1306_t * dev);
 int ssd1306_get_height(SSD1306_t * dev);
 int ssd1306_get_pages(SSD1306_t * dev);
 void ssd1306_show_buffer(SSD1306_t * dev);
+void ssd1306_show_frame(SSD1306_t * dev);
+void ssd1306_swap_buffer(SSD1306_t * dev);
+void ssd1306_start_flush_task(SSD1306_t * dev, int priority);
+void ssd1306_flush_wait(SSD1306_t * dev);
+void ssd1306_set_controller(SSD1306_t * dev, ssd1306_controller_t controller);
+void ssd1306_mark_dirty(SSD1306_t * dev, int page, int seg, int width);
+void ssd1306_clear_dirty(SSD1306_t * dev);
+void ssd1306_get_bus_stats(SSD1306_t * dev, ssd1306_bus_stats_t * stats);
+void ssd1306_reset_bus_stats(SSD1306_t * dev);
+void ssd1306_log_bus_stats(SSD1306_t * dev, const char * label, const ssd1306_bus_stats_t * stats);
+void ssd1306_count_transfer(SSD1306_t * dev, int command_bytes, int payload_bytes, bool ok);
+void ssd1306_copy_segs(SSD1306_t * dev, uint8_t * dst, const uint8_t * src, int width);
 void ssd1306_set_buffer(SSD1306_t * dev, uint8_t * buffer);
 void ssd1306_get_buffer(SSD1306_t * dev, uint8_t * buffer);
 void ssd1306_display_image(SSD1306_t * dev, int page, int seg, uint8_t * images, int width);
@@ -128,8 +252,15 @@ void ssd1306_display_text(SSD1306_t * dev, int page, char * text, int text_len,
 void ssd1306_display_text_box1(SSD1306_t * dev, int page, int seg, char * text, int box_width, int text_len, bool invert, int delay);
 void ssd1306_display_text_box2(SSD1306_t * dev, int page, int seg, char * text, int box_width, int text_len, bool invert, int delay);
 void ssd1306_display_text_x3(SSD1306_t * dev, int page, char * text, int text_len, bool invert);
+void ssd1306_display_text_scaled(SSD1306_t * dev, int page, int seg, char * text, int text_len, int scale, bool invert);
 void ssd1306_clear_screen(SSD1306_t * dev, bool invert);
 void ssd1306_clear_line(SSD1306_t * dev, int page, bool invert);
+void _ssd1306_display_image(SSD1306_t * dev, int page, int seg, uint8_t * images, int width);
+void _ssd1306_display_text(SSD1306_t * dev, int page, char * text, int text_len, bool invert);
+void _ssd1306_display_text_x3(SSD1306_t * dev, int page, char * text, int text_len, bool invert);
+void _ssd1306_display_text_scaled(SSD1306_t * dev, int page, int seg, char * text, int text_len, int scale, bool invert);
+void _ssd1306_clear_screen(SSD1306_t * dev, bool invert);
+void _ssd1306_clear_line(SSD1306_t * dev, int page, bool invert);
 void ssd1306_contrast(SSD1306_t * dev, int contrast);
 void ssd1306_software_scroll(SSD1306_t * dev, int start, int end);
 void ssd1306_scroll_text(SSD1306_t * dev, char * text, int text_len, bool invert);
@@ -138,6 +269,15 @@ void ssd1306_hardware_scroll(SSD1306_t * dev, ssd1306_scroll_type_t scroll);
 void ssd1306_wrap_arround(SSD1306_t * dev, ssd1306_scroll_type_t scroll, int start, int end, int8_t delay);
 void _ssd1306_bitmaps(SSD1306_t * dev, int xpos, int ypos, uint8_t * bitmap, int width, int height, bool invert);
 void ssd1306_bitmaps(SSD1306_t * dev, int xpos, int ypos, uint8_t * bitmap, int width, int height, bool invert);
+void _ssd1306_blit(SSD1306_t * dev, int xpos, int ypos, const uint8_t * bitmap, int width, int height, ssd1306_blit_mode_t mode, bool invert);
+void _ssd1306_blit_columns(SSD1306_t * dev, int xpos, int ypos, const uint8_t * columns, int width, int height, ssd1306_blit_mode_t mode, bool invert);
+void _ssd1306_draw_icon(SSD1306_t * dev, const ssd1306_icon_t * icon, int xpos, int ypos, bool invert);
+int ssd1306_text_width(const ssd1306_font_t * font, char * text, int text_len);
+int _ssd1306_draw_text(SSD1306_t * dev, const ssd1306_font_t * font, int xpos, int ypos, char * text, int text_len, ssd1306_blit_mode_t mode);
+int ssd1306_draw_text(SSD1306_t * dev, const ssd1306_font_t * font, int xpos, int ypos, char * text, int text_len, ssd1306_blit_mode_t mode);
+bool ssd1306_marquee_init(SSD1306_t * dev, ssd1306_marquee_t * marquee, const ssd1306_font_t * font, int page, int seg, int window, char * text, int text_len);
+void _ssd1306_marquee_step(SSD1306_t * dev, ssd1306_marquee_t * marquee, int step);
+void ssd1306_marquee_free(ssd1306_marquee_t * marquee);
 void _ssd1306_pixel(SSD1306_t * dev, int xpos, int ypos, bool invert);
 void _ssd1306_line(SSD1306_t * dev, int x1, int y1, int x2, int y2,  bool invert);
 void _ssd1306_circle(SSD1306_t * dev, int x0, int y0, int r, bool invert);
@@ -147,27 +287,40 @@ void ssd1306_flip(uint8_t *buf, size_t blen);
 uint8_t ssd1306_copy_bit(uint8_t src, int srcBits, uint8_t dst, int dstBits);
 uint8_t ssd1306_rotate_byte(uint8_t ch1);
 void ssd1306_fadeout(SSD1306_t * dev);
+bool ssd1306_anim_begin(SSD1306_t * dev);
+TickType_t ssd1306_anim_start(SSD1306_t * dev, ssd1306_anim_type_t type, int duration_ms);
+TickType_t ssd1306_anim_step(SSD1306_t * dev);
+void ssd1306_anim_finish(SSD1306_t * dev);
+void ssd1306_animate(SSD1306_t * dev, ssd1306_anim_type_t type, int duration_ms);
 void ssd1306_rotate_image(uint8_t *image, bool flip);
 void ssd1306_display_rotate_text(SSD1306_t * dev, int seg, char * text, int text_len, bool invert);
 void ssd1306_dump(SSD1306_t dev);
 void ssd1306_dump_page(SSD1306_t * dev, int page, int seg);
 
+#if !CONFIG_IDF_TARGET_LINUX
+void i2c_clock_speed(int speed);
 void i2c_master_init(SSD1306_t * dev, int16_t sda, int16_t scl, int16_t reset);
 void i2c_device_add(SSD1306_t * dev, i2c_port_t i2c_num, int16_t reset);
 void i2c_bus_add(SSD1306_t * dev, i2c_master_bus_handle_t bus_handle, i2c_port_t i2c_num, int16_t reset);
+void i2c_shared_add(SSD1306_t * dev, i2c_port_t i2c_num, ssd1306_i2c_write_t write, void * ctx, int16_t reset);
+#endif
 void i2c_init(SSD1306_t * dev, int width, int height);
 void i2c_display_image(SSD1306_t * dev, int page, int seg, uint8_t * images, int width);
+void i2c_display_frame(SSD1306_t * dev, PAGE_t * pages);
 void i2c_contrast(SSD1306_t * dev, int contrast);
 void i2c_hardware_scroll(SSD1306_t * dev, ssd1306_scroll_type_t scroll);
 
+#if !CONFIG_IDF_TARGET_LINUX
 void spi_clock_speed(int speed);
 void spi_master_init(SSD1306_t * dev, int16_t mosi, int16_t sclk, int16_t cs, int16_t dc, int16_t reset);
 void spi_device_add(SSD1306_t * dev, int16_t cs, int16_t dc, int16_t reset);
 bool spi_master_write_byte(spi_device_handle_t SPIHandle, const uint8_t* Data, size_t DataLength );
 bool spi_master_write_command(SSD1306_t * dev, uint8_t Command );
 bool spi_master_write_data(SSD1306_t * dev, const uint8_t* Data, size_t DataLength );
+#endif
 void spi_init(SSD1306_t * dev, int width, int height);
 void spi_display_image(SSD1306_t * dev, int page, int seg, uint8_t * images, int width);
+void spi_display_frame(SSD1306_t * dev, PAGE_t * pages);
 void spi_contrast(SSD1306_t * dev, int contrast);
 void spi_hardware_scroll(SSD1306_t * dev, ssd1306_scroll_type_t scroll);
 
@@ -0,0 +1,596 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "esp_log.h"
+
+#include "ssd1306.h"
+#include "ssd1306_emu.h"
+
+#define TAG "SSD1306_EMU"
+
+// Host emulator of the panel side of the bus.
+// Transactions are encoded exactly like ssd1306_i2c_legacy.c and decoded by a small
+// model of the controller, so the snapshots show what the real panel would show and
+// the counters match the bytes the I2C transport puts on the wire.
+// Hardware scrolling is tracked but not animated.
+
+#define EMU_PAGES 8
+#define EMU_WIDTH 128
+
+typedef struct {
+	uint8_t ram[EMU_PAGES][SSD1306_EMU_COLUMNS];
+	bool horizontal;	// Horizontal addressing mode, page addressing otherwise
+	int column;
+	int page;
+	int columnStart;	// Horizontal addressing window
+	int columnEnd;
+	int pageStart;
+	int pageEnd;
+	uint8_t contrast;
+	bool on;
+	bool inverted;
+	bool allOn;
+	bool segRemap;		// A1: column 0 drives the rightmost segment
+	bool comRemap;		// C8: COM scan from the bottom
+	int startLine;
+	int muxRatio;
+	bool scrolling;
+	uint8_t command[8];	// Command being assembled
+	int commandLen;
+	int commandArgs;	// Argument bytes still expected for command
+} emu_panel_t;
+
+static emu_panel_t panel;
+static ssd1306_emu_stats_t stats;
+static SemaphoreHandle_t emuLock;
+
+static void emu_reset(void)
+{
+	memset(&panel, 0, sizeof(panel));
+	panel.columnEnd = SSD1306_EMU_COLUMNS - 1;
+	panel.pageEnd = EMU_PAGES - 1;
+	panel.contrast = 0x7F;
+	panel.muxRatio = 63;
+}
+
+// Number of argument bytes that follow a command byte
+static int emu_command_args(uint8_t command)
+{
+	switch (command) {
+	case OLED_CMD_SET_CONTRAST:
+	case OLED_CMD_SET_MEMORY_ADDR_MODE:
+	case OLED_CMD_SET_MUX_RATIO:
+	case OLED_CMD_SET_DISPLAY_OFFSET:
+	case OLED_CMD_SET_DISPLAY_CLK_DIV:
+	case OLED_CMD_SET_PRECHARGE:
+	case OLED_CMD_SET_COM_PIN_MAP:
+	case OLED_CMD_SET_VCOMH_DESELCT:
+	case OLED_CMD_SET_CHARGE_PUMP:
+		return 1;
+	case OLED_CMD_SET_COLUMN_RANGE:
+	case OLED_CMD_SET_PAGE_RANGE:
+	case OLED_CMD_VERTICAL:
+		return 2;
+	case OLED_CMD_CONTINUOUS_SCROLL:
+	case 0x2A:
+		return 5;
+	case OLED_CMD_HORIZONTAL_RIGHT:
+	case OLED_CMD_HORIZONTAL_LEFT:
+		return 6;
+	default:
+		return 0;
+	}
+}
+
+static void emu_execute(const uint8_t * command)
+{
+	uint8_t op = command[0];
+	if (op <= 0x0F) {
+		panel.column = (panel.column & 0xF0) | op;
+	} else if (op <= 0x1F) {
+		panel.column = (panel.column & 0x0F) | ((op & 0x0F) << 4);
+	} else if (op >= 0x40 && op <= 0x7F) {
+		panel.startLine = op & 0x3F;
+	} else if (op >= 0xB0 && op <= 0xB7) {
+		panel.page = op & 0x07;
+	} else {
+		switch (op) {
+		case OLED_CMD_SET_MEMORY_ADDR_MODE:
+			panel.horizontal = (command[1] & 0x03) == OLED_CMD_SET_HORI_ADDR_MODE;
+			break;
+		case OLED_CMD_SET_COLUMN_RANGE:
+			panel.columnStart = command[1] % SSD1306_EMU_COLUMNS;
+			panel.columnEnd = command[2] % SSD1306_EMU_COLUMNS;
+			panel.column = panel.columnStart;
+			break;
+		case OLED_CMD_SET_PAGE_RANGE:
+			panel.pageStart = command[1] & 0x07;
+			panel.pageEnd = command[2] & 0x07;
+			panel.page = panel.pageStart;
+			break;
+		case OLED_CMD_SET_CONTRAST:
+			panel.contrast = command[1];
+			break;
+		case OLED_CMD_SET_MUX_RATIO:
+			panel.muxRatio = command[1] & 0x3F;
+			break;
+		case OLED_CMD_SET_SEGMENT_REMAP_0:
+		case OLED_CMD_SET_SEGMENT_REMAP_1:
+			panel.segRemap = op & 0x01;
+			break;
+		case 0xC0:
+		case OLED_CMD_SET_COM_SCAN_MODE:
+			panel.comRemap = op == OLED_CMD_SET_COM_SCAN_MODE;
+			break;
+		case OLED_CMD_DISPLAY_RAM:
+		case OLED_CMD_DISPLAY_ALLON:
+			panel.allOn = op == OLED_CMD_DISPLAY_ALLON;
+			break;
+		case OLED_CMD_DISPLAY_NORMAL:
+		case OLED_CMD_DISPLAY_INVERTED:
+			panel.inverted = op == OLED_CMD_DISPLAY_INVERTED;
+			break;
+		case OLED_CMD_DISPLAY_OFF:
+		case OLED_CMD_DISPLAY_ON:
+			panel.on = op == OLED_CMD_DISPLAY_ON;
+			break;
+		case OLED_CMD_ACTIVE_SCROLL:
+		case OLED_CMD_DEACTIVE_SCROLL:
+			panel.scrolling = op == OLED_CMD_ACTIVE_SCROLL;
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+static void emu_command(uint8_t byte)
+{
+	stats.commands++;
+	if (panel.commandLen == 0) {
+		panel.command[panel.commandLen++] = byte;
+		panel.commandArgs = emu_command_args(byte);
+	} else {
+		panel.command[panel.commandLen++] = byte;
+		panel.commandArgs--;
+	}
+	if (panel.commandArgs == 0) {
+		emu_execute(panel.command);
+		panel.commandLen = 0;
+	}
+}
+
+static void emu_data(uint8_t byte)
+{
+	stats.data++;
+	if (panel.column < SSD1306_EMU_COLUMNS) {
+		panel.ram[panel.page][panel.column] = byte;
+	}
+	if (!panel.horizontal) {
+		// Page addressing stops at the last column
+		if (panel.column < SSD1306_EMU_COLUMNS - 1) panel.column++;
+		return;
+	}
+	if (panel.column < panel.columnEnd) {
+		panel.column++;
+		return;
+	}
+	panel.column = panel.columnStart;
+	panel.page = panel.page < panel.pageEnd ? panel.page + 1 : panel.pageStart;
+}
+
+// Decode one bus transaction: a control byte then either a stream or a single byte
+void ssd1306_emu_write(const uint8_t * buf, int len)
+{
+	if (emuLock) xSemaphoreTake(emuLock, portMAX_DELAY);
+	stats.transactions++;
+	stats.bytes += len + 1; // Address byte
+	int index = 0;
+	while (index < len) {
+		uint8_t control = buf[index++];
+		bool data = control & 0x40;
+		bool single = control & 0x80;
+		int end = single ? index + 1 : len;
+		if (end > len) end = len;
+		for (; index < end; index++) {
+			if (data) {
+				emu_data(buf[index]);
+			} else {
+				emu_command(buf[index]);
+			}
+		}
+	}
+	if (emuLock) xSemaphoreGive(emuLock);
+}
+
+void ssd1306_emu_init(SSD1306_t * dev)
+{
+	if (emuLock == NULL) emuLock = xSemaphoreCreateMutex();
+	emu_reset();
+	ssd1306_emu_reset_stats();
+	dev->_address = I2C_ADDRESS;
+	dev->_flip = false;
+}
+
+void ssd1306_emu_get_stats(ssd1306_emu_stats_t * out)
+{
+	if (emuLock) xSemaphoreTake(emuLock, portMAX_DELAY);
+	*out = stats;
+	if (emuLock) xSemaphoreGive(emuLock);
+}
+
+void ssd1306_emu_reset_stats(void)
+{
+	if (emuLock) xSemaphoreTake(emuLock, portMAX_DELAY);
+	memset(&stats, 0, sizeof(stats));
+	if (emuLock) xSemaphoreGive(emuLock);
+}
+
+// Render what the panel shows as 8 bit gray, width x height, row by row.
+// A1/C8 is the orientation ssd1306_init configures, so it renders upright.
+void ssd1306_emu_get_framebuffer(uint8_t * pixels, int width, int height)
+{
+	if (emuLock) xSemaphoreTake(emuLock, portMAX_DELAY);
+	// Lit pixels never go fully dark, even at contrast 0
+	uint8_t lit = 64 + (panel.contrast * 191) / 255;
+	int rows = panel.muxRatio + 1;
+	for (int y=0;y<height;y++) {
+		for (int x=0;x<width;x++) {
+			bool on = false;
+			if (panel.on && x < EMU_WIDTH && y < rows) {
+				int row = panel.comRemap ? y : rows - 1 - y;
+				row = (row + panel.startLine) & 0x3F;
+				int column = CONFIG_OFFSETX + (panel.segRemap ? x : EMU_WIDTH - 1 - x);
+				on = (panel.ram[row / 8][column] >> (row % 8)) & 1;
+				if (panel.inverted) on = !on;
+				if (panel.allOn) on = true;
+			}
+			pixels[y * width + x] = on ? lit : 0;
+		}
+	}
+	if (emuLock) xSemaphoreGive(emuLock);
+}
+
+static uint8_t * emu_snapshot(int scale, int * width, int * height)
+{
+	if (scale < 1) scale = 1;
+	int rows = panel.muxRatio + 1;
+	uint8_t * frame = malloc(EMU_WIDTH * rows);
+	uint8_t * image = malloc(EMU_WIDTH * scale * rows * scale);
+	if (frame == NULL || image == NULL) {
+		ESP_LOGE(TAG, "snapshot alloc fail");
+		free(frame);
+		free(image);
+		return NULL;
+	}
+	ssd1306_emu_get_framebuffer(frame, EMU_WIDTH, rows);
+	*width = EMU_WIDTH * scale;
+	*height = rows * scale;
+	for (int y=0;y<*height;y++) {
+		for (int x=0;x<*width;x++) {
+			image[y * *width + x] = frame[(y / scale) * EMU_WIDTH + x / scale];
+		}
+	}
+	free(frame);
+	return image;
+}
+
+bool ssd1306_emu_save_pgm(const char * path, int scale)
+{
+	int width, height;
+	uint8_t * image = emu_snapshot(scale, &width, &height);
+	if (image == NULL) return false;
+	FILE * f = fopen(path, "wb");
+	bool ok = f != NULL;
+	if (ok) {
+		fprintf(f, "P5\n%d %d\n255\n", width, height);
+		ok = fwrite(image, 1, width * height, f) == (size_t)(width * height);
+		ok = (fclose(f) == 0) && ok;
+	}
+	if (!ok) ESP_LOGE(TAG, "cannot write %s", path);
+	free(image);
+	return ok;
+}
+
+// Compare what the panel shows with a snapshot saved by ssd1306_emu_save_pgm at scale 1.
+// Returns the number of pixels that differ, -1 when the file is missing or of another size.
+int ssd1306_emu_diff_pgm(const char * path)
+{
+	int width, height;
+	uint8_t * image = emu_snapshot(1, &width, &height);
+	if (image == NULL) return -1;
+	int diff = -1;
+	int _width, _height, maxval;
+	FILE * f = fopen(path, "rb");
+	if (f != NULL && fscanf(f, "P5 %d %d %d", &_width, &_height, &maxval) == 3 && fgetc(f) != EOF
+		&& _width == width && _height == height && maxval == 255) {
+		diff = 0;
+		for (int i=0;i<width*height;i++) {
+			int pixel = fgetc(f);
+			if (pixel == EOF) {
+				diff = -1;
+				break;
+			}
+			if (pixel != image[i]) diff++;
+		}
+	}
+	if (f != NULL) fclose(f);
+	free(image);
+	return diff;
+}
+
+static uint32_t emu_crc32(uint32_t crc, const uint8_t * buf, size_t len)
+{
+	crc = ~crc;
+	for (size_t i=0;i<len;i++) {
+		crc ^= buf[i];
+		for (int bit=0;bit<8;bit++) {
+			crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+		}
+	}
+	return ~crc;
+}
+
+static void emu_put32(uint8_t * out, uint32_t value)
+{
+	out[0] = value >> 24;
+	out[1] = value >> 16;
+	out[2] = value >> 8;
+	out[3] = value;
+}
+
+static bool emu_png_chunk(FILE * f, const char * type, const uint8_t * data, size_t len)
+{
+	uint8_t head[8];
+	uint8_t tail[4];
+	emu_put32(head, len);
+	memcpy(&head[4], type, 4);
+	uint32_t crc = emu_crc32(0, &head[4], 4);
+	crc = emu_crc32(crc, data, len);
+	emu_put32(tail, crc);
+	return fwrite(head, 1, 8, f) == 8
+		&& (len == 0 || fwrite(data, 1, len, f) == len)
+		&& fwrite(tail, 1, 4, f) == 4;
+}
+
+// 8 bit grayscale PNG with the image data in stored (uncompressed) deflate blocks,
+// which keeps the emulator free of a zlib dependency
+bool ssd1306_emu_save_png(const char * path, int scale)
+{
+	int width, height;
+	uint8_t * image = emu_snapshot(scale, &width, &height);
+	if (image == NULL) return false;
+
+	size_t raw_len = (size_t)(width + 1) * height; // Filter byte per row
+	size_t blocks = (raw_len + 0xFFFE) / 0xFFFF;
+	size_t zlib_len = 2 + raw_len + blocks * 5 + 4;
+	uint8_t * zlib = malloc(zlib_len);
+	if (zlib == NULL) {
+		ESP_LOGE(TAG, "png alloc fail");
+		free(image);
+		return false;
+	}
+
+	size_t out = 0;
+	zlib[out++] = 0x78; // Deflate, 32K window
+	zlib[out++] = 0x01;
+	uint32_t adler_a = 1, adler_b = 0;
+	size_t raw = 0;
+	while (raw < raw_len) {
+		size_t block = raw_len - raw;
+		if (block > 0xFFFF) block = 0xFFFF;
+		zlib[out++] = (raw + block == raw_len) ? 0x01 : 0x00;
+		zlib[out++] = block & 0xFF;
+		zlib[out++] = block >> 8;
+		zlib[out++] = ~block & 0xFF;
+		zlib[out++] = (~block >> 8) & 0xFF;
+		for (size_t i=0;i<block;i++,raw++) {
+			size_t x = raw % (width + 1);
+			uint8_t byte = x == 0 ? 0 : image[(raw / (width + 1)) * width + x - 1];
+			zlib[out++] = byte;
+			adler_a = (adler_a + byte) % 65521;
+			adler_b = (adler_b + adler_a) % 65521;
+		}
+	}
+	emu_put32(&zlib[out], (adler_b << 16) | adler_a);
+	out += 4;
+
+	uint8_t ihdr[13];
+	emu_put32(&ihdr[0], width);
+	emu_put32(&ihdr[4], height);
+	ihdr[8] = 8;	// Bit depth
+	ihdr[9] = 0;	// Grayscale
+	ihdr[10] = 0;	// Deflate
+	ihdr[11] = 0;	// Adaptive filtering
+	ihdr[12] = 0;	// No interlace
+
+	static const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+	FILE * f = fopen(path, "wb");
+	bool ok = f != NULL;
+	if (ok) {
+		ok = fwrite(signature, 1, sizeof(signature), f) == sizeof(signature)
+			&& emu_png_chunk(f, "IHDR", ihdr, sizeof(ihdr))
+			&& emu_png_chunk(f, "IDAT", zlib, out)
+			&& emu_png_chunk(f, "IEND", NULL, 0);
+		ok = (fclose(f) == 0) && ok;
+	}
+	if (!ok) ESP_LOGE(TAG, "cannot write %s", path);
+	free(zlib);
+	free(image);
+	return ok;
+}
+
+// Transport functions called by ssd1306.c, encoded like ssd1306_i2c_legacy.c
+
+static void emu_transmit(SSD1306_t * dev, const uint8_t * buf, int len, int payload)
+{
+	ssd1306_emu_write(buf, len);
+	ssd1306_count_transfer(dev, len - payload + 1, payload, true);
+}
+
+void i2c_init(SSD1306_t * dev, int width, int height) {
+	dev->_width = width;
+	dev->_height = height;
+	dev->_pages = 8;
+	if (dev->_height == 32) dev->_pages = 4;
+
+	uint8_t out_buf[32];
+	int out_index = 0;
+	out_buf[out_index++] = OLED_CONTROL_BYTE_CMD_STREAM;
+	out_buf[out_index++] = OLED_CMD_DISPLAY_OFF;				// AE
+	out_buf[out_index++] = OLED_CMD_SET_MUX_RATIO;				// A8
+	out_buf[out_index++] = dev->_height == 32 ? 0x1F : 0x3F;
+	out_buf[out_index++] = OLED_CMD_SET_DISPLAY_OFFSET;			// D3
+	out_buf[out_index++] = 0x00;
+	out_buf[out_index++] = OLED_CMD_SET_DISPLAY_START_LINE;		// 40
+	out_buf[out_index++] = dev->_flip ? OLED_CMD_SET_SEGMENT_REMAP_0 : OLED_CMD_SET_SEGMENT_REMAP_1;
+	out_buf[out_index++] = OLED_CMD_SET_COM_SCAN_MODE;			// C8
+	out_buf[out_index++] = OLED_CMD_SET_DISPLAY_CLK_DIV;		// D5
+	out_buf[out_index++] = 0x80;
+	out_buf[out_index++] = OLED_CMD_SET_COM_PIN_MAP;			// DA
+	out_buf[out_index++] = dev->_height == 32 ? 0x02 : 0x12;
+	out_buf[out_index++] = OLED_CMD_SET_CONTRAST;				// 81
+	out_buf[out_index++] = 0xFF;
+	out_buf[out_index++] = OLED_CMD_DISPLAY_RAM;				// A4
+	out_buf[out_index++] = OLED_CMD_SET_VCOMH_DESELCT;			// DB
+	out_buf[out_index++] = 0x40;
+	out_buf[out_index++] = OLED_CMD_SET_MEMORY_ADDR_MODE;		// 20
+	out_buf[out_index++] = OLED_CMD_SET_PAGE_ADDR_MODE;			// 02
+	out_buf[out_index++] = 0x00;
+	out_buf[out_index++] = 0x10;
+	out_buf[out_index++] = OLED_CMD_SET_CHARGE_PUMP;			// 8D
+	out_buf[out_index++] = 0x14;
+	out_buf[out_index++] = OLED_CMD_DEACTIVE_SCROLL;			// 2E
+	out_buf[out_index++] = OLED_CMD_DISPLAY_NORMAL;				// A6
+	out_buf[out_index++] = OLED_CMD_DISPLAY_ON;					// AF
+	emu_transmit(dev, out_buf, out_index, 0);
+	ESP_LOGI(TAG, "Emulated OLED configured");
+}
+
+void i2c_display_image(SSD1306_t * dev, int page, int seg, uint8_t * images, int width) {
+	if (page >= dev->_pages) return;
+	if (seg >= dev->_width) return;
+	if (dev->_tx_buf == NULL) return;
+	if (width > dev->_width - seg) width = dev->_width - seg;
+
+	int _seg = seg + CONFIG_OFFSETX;
+	int _page = page;
+	if (dev->_flip) {
+		_page = (dev->_pages - page) - 1;
+	}
+
+	uint8_t *out_buf = dev->_tx_buf;
+	int out_index = 0;
+	out_buf[out_index++] = OLED_CONTROL_BYTE_CMD_STREAM;
+	if (dev->_horizontal) {
+		out_buf[out_index++] = OLED_CMD_SET_MEMORY_ADDR_MODE;	// 20
+		out_buf[out_index++] = OLED_CMD_SET_PAGE_ADDR_MODE;		// 02
+		dev->_horizontal = false;
+	}
+	out_buf[out_index++] = 0x00 + (_seg & 0x0F);
+	out_buf[out_index++] = 0x10 + ((_seg >> 4) & 0x0F);
+	out_buf[out_index++] = 0xB0 | _page;
+	emu_transmit(dev, out_buf, out_index, 0);
+
+	out_buf[0] = OLED_CONTROL_BYTE_DATA_STREAM;
+	ssd1306_copy_segs(dev, &out_buf[1], images, width);
+	emu_transmit(dev, out_buf, width + 1, width);
+}
+
+void i2c_display_frame(SSD1306_t * dev, PAGE_t * pages) {
+	if (dev->_tx_buf == NULL) return;
+
+	uint8_t *out_buf = dev->_tx_buf;
+	int out_index = 0;
+	if (!dev->_horizontal) {
+		out_buf[out_index++] = OLED_CONTROL_BYTE_CMD_SINGLE;
+		out_buf[out_index++] = OLED_CMD_SET_MEMORY_ADDR_MODE;	// 20
+		out_buf[out_index++] = OLED_CONTROL_BYTE_CMD_SINGLE;
+		out_buf[out_index++] = OLED_CMD_SET_HORI_ADDR_MODE;		// 00
+		dev->_horizontal = true;
+	}
+	const uint8_t commands[] = {
+		OLED_CMD_SET_COLUMN_RANGE, CONFIG_OFFSETX, CONFIG_OFFSETX + dev->_width - 1,
+		OLED_CMD_SET_PAGE_RANGE, 0x00, dev->_pages - 1
+	};
+	for (int i=0;i<sizeof(commands);i++) {
+		out_buf[out_index++] = OLED_CONTROL_BYTE_CMD_SINGLE;
+		out_buf[out_index++] = commands[i];
+	}
+	out_buf[out_index++] = OLED_CONTROL_BYTE_DATA_STREAM;
+	for (int page=0; page<dev->_pages; page++) {
+		int _page = page;
+		if (dev->_flip) {
+			_page = (dev->_pages - page) - 1;
+		}
+		ssd1306_copy_segs(dev, &out_buf[out_index], pages[_page]._segs, dev->_width);
+		out_index = out_index + dev->_width;
+	}
+	emu_transmit(dev, out_buf, out_index, dev->_pages * dev->_width);
+}
+
+void i2c_contrast(SSD1306_t * dev, int contrast) {
+	int _contrast = contrast;
+	if (contrast < 0x0) _contrast = 0;
+	if (contrast > 0xFF) _contrast = 0xFF;
+
+	uint8_t out_buf[3] = { OLED_CONTROL_BYTE_CMD_STREAM, OLED_CMD_SET_CONTRAST, _contrast };
+	emu_transmit(dev, out_buf, sizeof(out_buf), 0);
+}
+
+void i2c_hardware_scroll(SSD1306_t * dev, ssd1306_scroll_type_t scroll) {
+	uint8_t out_buf[16];
+	int out_index = 0;
+	out_buf[out_index++] = OLED_CONTROL_BYTE_CMD_STREAM;
+	if (scroll == SCROLL_RIGHT || scroll == SCROLL_LEFT) {
+		out_buf[out_index++] = scroll == SCROLL_RIGHT ? OLED_CMD_HORIZONTAL_RIGHT : OLED_CMD_HORIZONTAL_LEFT;
+		out_buf[out_index++] = 0x00; // Dummy byte
+		out_buf[out_index++] = 0x00; // Start page
+		out_buf[out_index++] = 0x07; // Frame frequency
+		out_buf[out_index++] = 0x07; // End page
+		out_buf[out_index++] = 0x00;
+		out_buf[out_index++] = 0xFF;
+		out_buf[out_index++] = OLED_CMD_ACTIVE_SCROLL; // 2F
+	}
+	if (scroll == SCROLL_DOWN || scroll == SCROLL_UP) {
+		out_buf[out_index++] = OLED_CMD_CONTINUOUS_SCROLL; // 29
+		out_buf[out_index++] = 0x00; // Dummy byte
+		out_buf[out_index++] = 0x00; // Start page
+		out_buf[out_index++] = 0x07; // Frame frequency
+		out_buf[out_index++] = 0x00; // End page
+		out_buf[out_index++] = scroll == SCROLL_DOWN ? 0x3F : 0x01; // Vertical scrolling offset
+		out_buf[out_index++] = OLED_CMD_VERTICAL; // A3
+		out_buf[out_index++] = 0x00;
+		out_buf[out_index++] = dev->_height == 32 ? 0x20 : 0x40;
+		out_buf[out_index++] = OLED_CMD_ACTIVE_SCROLL; // 2F
+	}
+	if (scroll == SCROLL_STOP) {
+		out_buf[out_index++] = OLED_CMD_DEACTIVE_SCROLL; // 2E
+	}
+	emu_transmit(dev, out_buf, out_index, 0);
+}
+
+// ssd1306_emu_init selects the I2C address, but the core links both transports
+
+void spi_init(SSD1306_t * dev, int width, int height) {
+	i2c_init(dev, width, height);
+}
+
+void spi_display_image(SSD1306_t * dev, int page, int seg, uint8_t * images, int width) {
+	i2c_display_image(dev, page, seg, images, width);
+}
+
+void spi_display_frame(SSD1306_t * dev, PAGE_t * pages) {
+	i2c_display_frame(dev, pages);
+}
+
+void spi_contrast(SSD1306_t * dev, int contrast) {
+	i2c_contrast(dev, contrast);
+}
+
+void spi_hardware_scroll(SSD1306_t * dev, ssd1306_scroll_type_t scroll) {
+	i2c_hardware_scroll(dev, scroll);
+}
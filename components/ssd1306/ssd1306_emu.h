@@ -0,0 +1,39 @@
+#ifndef SSD1306_EMU_H_
+#define SSD1306_EMU_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "ssd1306.h"
+
+// Host-side panel emulator, built instead of the I2C/SPI transports for the linux target.
+// The transport functions produce the same command/data stream as ssd1306_i2c_legacy.c,
+// and the emulator decodes it into GDDRAM the way the controller does.
+//
+//	static SSD1306_t dev;
+//	ssd1306_emu_init(&dev);
+//	ssd1306_init(&dev, 128, 64);
+//	ui_show_volume(&dev, 40);
+//	ssd1306_emu_save_png("volume.png", 4);
+//
+// host_test/oled_ui renders every screen this way and compares it with golden images.
+
+#define SSD1306_EMU_COLUMNS 132 // SH1106 RAM width; the SSD1306 uses the first 128
+
+typedef struct {
+	uint32_t transactions;	// Bus transactions (one START..STOP each)
+	uint32_t bytes;			// Bytes on the bus including the address byte
+	uint32_t commands;		// Command bytes decoded
+	uint32_t data;			// GDDRAM bytes written
+} ssd1306_emu_stats_t;
+
+void ssd1306_emu_init(SSD1306_t * dev);
+void ssd1306_emu_write(const uint8_t * buf, int len);
+void ssd1306_emu_get_stats(ssd1306_emu_stats_t * stats);
+void ssd1306_emu_reset_stats(void);
+void ssd1306_emu_get_framebuffer(uint8_t * pixels, int width, int height);
+bool ssd1306_emu_save_pgm(const char * path, int scale);
+bool ssd1306_emu_save_png(const char * path, int scale);
+int ssd1306_emu_diff_pgm(const char * path);
+
+#endif /* SSD1306_EMU_H_ */
@@ -0,0 +1,44 @@
+#ifndef SSD1306_FONT_H_
+#define SSD1306_FONT_H_
+
+#include <stdint.h>
+
+// Proportional fonts generated by tools/fontconv.py.
+// Each glyph is cropped to its ink and stored as height bits per column, LSB at the top,
+// packed back to back from a byte aligned offset in bitmap.
+// Code points first..last are looked up directly. Glyphs beyond that range
+// (e.g. the Latin-1 supplement) are reached through ext_index, one byte per
+// code point of ext_first..ext_last, so every lookup is a single array access.
+
+#define SSD1306_FONT_MAX_HEIGHT 32
+#define SSD1306_FONT_MAX_WIDTH 32
+
+typedef struct {
+	uint16_t offset;	// Byte offset of the glyph in bitmap
+	uint8_t width;		// Columns of bitmap data, 0 for blank glyphs
+	int8_t xoffset;		// Columns between the cursor and the first bitmap column
+	uint8_t advance;	// Columns the cursor moves after the glyph
+} ssd1306_glyph_t;
+
+typedef struct {
+	uint8_t height;					// Pixel rows of every glyph
+	uint16_t first;					// Code point of glyphs[0]
+	uint16_t last;					// Code point of the last entry in glyphs
+	const ssd1306_glyph_t * glyphs;	// Indexed by code point - first
+	const uint8_t * bitmap;
+	uint16_t ext_first;				// First code point of ext_index
+	uint16_t ext_last;				// Last code point of ext_index
+	const uint8_t * ext_index;		// Position in glyphs, 0 when not covered; NULL for none
+} ssd1306_font_t;
+
+extern const ssd1306_font_t font_prop8;
+extern const ssd1306_font_t font_prop16;
+
+// font8x8_basic.h glyphs pre-scaled by tools/scaleconv.py for the scaled text renderer.
+// A glyph at scale s is s pages of 8*s columns, page after page, at
+// font8x8_scaled[s] + index * 8*s*s. font8x8_scaled_index gives the index of an
+// ASCII character, -1 for characters left out of the tables.
+extern const int8_t font8x8_scaled_index[128];
+extern const uint8_t * const font8x8_scaled[];
+
+#endif /* SSD1306_FONT_H_ */
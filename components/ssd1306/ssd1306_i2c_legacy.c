@@ -18,9 +18,23 @@
 #define I2C_NUM I2C_NUM_0 // if spi is selected
 #endif
 
-#define I2C_MASTER_FREQ_HZ 400000 // I2C clock of SSD1306 can run at 400 kHz max.
+#define I2C_MASTER_FREQ_HZ 400000 // I2C clock of SSD1306 can run at 400 kHz max. Default of i2c_clock_speed
 #define I2C_TICKS_TO_WAIT 100	  // Maximum ticks to wait before issuing a timeout.
 
+static int i2c_clock_speed_hz = I2C_MASTER_FREQ_HZ;
+
+// Set the SCL frequency used by the next i2c_master_init
+void i2c_clock_speed(int speed) {
+	ESP_LOGI(TAG, "I2C clock speed=%d kHz", speed/1000);
+	i2c_clock_speed_hz = speed;
+}
+
+// One write transaction, through the shared bus writer when i2c_shared_add was used
+static esp_err_t i2c_write(SSD1306_t * dev, const uint8_t * buf, size_t len) {
+	if (dev->_i2cWrite != NULL) return dev->_i2cWrite(dev->_i2cCtx, buf, len);
+	return i2c_master_write_to_device(dev->_i2c_num, dev->_address, buf, len, I2C_TICKS_TO_WAIT);
+}
+
 void i2c_master_init(SSD1306_t * dev, int16_t sda, int16_t scl, int16_t reset)
 {
 	ESP_LOGI(TAG, "Legacy i2c driver is used");
@@ -30,7 +44,7 @@ void i2c_master_init(SSD1306_t * dev, int16_t sda, int16_t scl, int16_t reset)
 		.scl_io_num = scl,
 		.sda_pullup_en = GPIO_PULLUP_ENABLE,
 		.scl_pullup_en = GPIO_PULLUP_ENABLE,
-		.master.clk_speed = I2C_MASTER_FREQ_HZ
+		.master.clk_speed = i2c_clock_speed_hz
 	};
 	ESP_ERROR_CHECK(i2c_param_config(I2C_NUM, &i2c_config));
 	ESP_ERROR_CHECK(i2c_driver_install(I2C_NUM, I2C_MODE_MASTER, 0, 0, 0));
@@ -47,6 +61,7 @@ void i2c_master_init(SSD1306_t * dev, int16_t sda, int16_t scl, int16_t reset)
 	dev->_address = I2C_ADDRESS;
 	dev->_flip = false;
 	dev->_i2c_num = I2C_NUM;
+	dev->_i2cWrite = NULL;
 }
 
 void i2c_device_add(SSD1306_t * dev, i2c_port_t i2c_num, int16_t reset)
@@ -60,7 +75,7 @@ void i2c_device_add(SSD1306_t * dev, i2c_port_t i2c_num, int16_t reset)
 		.scl_io_num = scl,
 		.sda_pullup_en = GPIO_PULLUP_ENABLE,
 		.scl_pullup_en = GPIO_PULLUP_ENABLE,
-		.master.clk_speed = I2C_MASTER_FREQ_HZ
+		.master.clk_speed = i2c_clock_speed_hz
 	};
 	ESP_ERROR_CHECK(i2c_param_config(I2C_NUM, &i2c_config));
 	ESP_ERROR_CHECK(i2c_driver_install(I2C_NUM, I2C_MODE_MASTER, 0, 0, 0));
@@ -78,6 +93,28 @@ void i2c_device_add(SSD1306_t * dev, i2c_port_t i2c_num, int16_t reset)
 	dev->_address = I2C_ADDRESS;
 	dev->_flip = false;
 	dev->_i2c_num = i2c_num;
+	dev->_i2cWrite = NULL;
+}
+
+// Attach the panel to a bus owned by someone else, e.g. a bus manager that arbitrates
+// it between several devices. Every transaction goes through write(ctx, ...).
+void i2c_shared_add(SSD1306_t * dev, i2c_port_t i2c_num, ssd1306_i2c_write_t write, void * ctx, int16_t reset)
+{
+	ESP_LOGI(TAG, "Shared i2c bus is used");
+
+	if (reset >= 0) {
+		gpio_reset_pin(reset);
+		gpio_set_direction(reset, GPIO_MODE_OUTPUT);
+		gpio_set_level(reset, 0);
+		vTaskDelay(50 / portTICK_PERIOD_MS);
+		gpio_set_level(reset, 1);
+	}
+
+	dev->_address = I2C_ADDRESS;
+	dev->_flip = false;
+	dev->_i2c_num = i2c_num;
+	dev->_i2cWrite = write;
+	dev->_i2cCtx = ctx;
 }
 
 void i2c_init(SSD1306_t * dev, int width, int height) {
@@ -86,64 +123,62 @@ void i2c_init(SSD1306_t * dev, int width, int height) {
 	dev->_pages = 8;
 	if (dev->_height == 32) dev->_pages = 4;
 	
-	i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-
-	i2c_master_start(cmd);
-	i2c_master_write_byte(cmd, (dev->_address << 1) | I2C_MASTER_WRITE, true);
-	i2c_master_write_byte(cmd, OLED_CONTROL_BYTE_CMD_STREAM, true);
-	i2c_master_write_byte(cmd, OLED_CMD_DISPLAY_OFF, true);				// AE
-	i2c_master_write_byte(cmd, OLED_CMD_SET_MUX_RATIO, true);			// A8
-	if (dev->_height == 64) i2c_master_write_byte(cmd, 0x3F, true);
-	if (dev->_height == 32) i2c_master_write_byte(cmd, 0x1F, true);
-	i2c_master_write_byte(cmd, OLED_CMD_SET_DISPLAY_OFFSET, true);		// D3
-	i2c_master_write_byte(cmd, 0x00, true);
-	//i2c_master_write_byte(cmd, OLED_CONTROL_BYTE_DATA_STREAM, true);	// 40
-	i2c_master_write_byte(cmd, OLED_CMD_SET_DISPLAY_START_LINE, true);	// 40
-	//i2c_master_write_byte(cmd, OLED_CMD_SET_SEGMENT_REMAP, true);		// A1
+	uint8_t out_buf[27];
+	int out_index = 0;
+	out_buf[out_index++] = OLED_CONTROL_BYTE_CMD_STREAM;
+	out_buf[out_index++] = OLED_CMD_DISPLAY_OFF;				// AE
+	out_buf[out_index++] = OLED_CMD_SET_MUX_RATIO;			 // A8
+	if (dev->_height == 64) out_buf[out_index++] = 0x3F;
+	if (dev->_height == 32) out_buf[out_index++] = 0x1F;
+	out_buf[out_index++] = OLED_CMD_SET_DISPLAY_OFFSET;		 // D3
+	out_buf[out_index++] = 0x00;
+	//out_buf[out_index++] = OLED_CONTROL_BYTE_DATA_STREAM;	// 40
+	out_buf[out_index++] = OLED_CMD_SET_DISPLAY_START_LINE;	// 40
+	//out_buf[out_index++] = OLED_CMD_SET_SEGMENT_REMAP;		// A1
 	if (dev->_flip) {
-		i2c_master_write_byte(cmd, OLED_CMD_SET_SEGMENT_REMAP_0, true); // A0
+		out_buf[out_index++] = OLED_CMD_SET_SEGMENT_REMAP_0; // A0
 	} else {
-		i2c_master_write_byte(cmd, OLED_CMD_SET_SEGMENT_REMAP_1, true);	// A1
+		out_buf[out_index++] = OLED_CMD_SET_SEGMENT_REMAP_1;	// A1
 	}
-	i2c_master_write_byte(cmd, OLED_CMD_SET_COM_SCAN_MODE, true);		// C8
-	i2c_master_write_byte(cmd, OLED_CMD_SET_DISPLAY_CLK_DIV, true);		// D5
-	i2c_master_write_byte(cmd, 0x80, true);
-	i2c_master_write_byte(cmd, OLED_CMD_SET_COM_PIN_MAP, true);			// DA
-	if (dev->_height == 64) i2c_master_write_byte(cmd, 0x12, true);
-	if (dev->_height == 32) i2c_master_write_byte(cmd, 0x02, true);
-	i2c_master_write_byte(cmd, OLED_CMD_SET_CONTRAST, true);			// 81
-	i2c_master_write_byte(cmd, 0xFF, true);
-	i2c_master_write_byte(cmd, OLED_CMD_DISPLAY_RAM, true);				// A4
-	i2c_master_write_byte(cmd, OLED_CMD_SET_VCOMH_DESELCT, true);		// DB
-	i2c_master_write_byte(cmd, 0x40, true);
-	i2c_master_write_byte(cmd, OLED_CMD_SET_MEMORY_ADDR_MODE, true);	// 20
-	//i2c_master_write_byte(cmd, OLED_CMD_SET_HORI_ADDR_MODE, true);	// 00
-	i2c_master_write_byte(cmd, OLED_CMD_SET_PAGE_ADDR_MODE, true);		// 02
+	out_buf[out_index++] = OLED_CMD_SET_COM_SCAN_MODE;		// C8
+	out_buf[out_index++] = OLED_CMD_SET_DISPLAY_CLK_DIV;		// D5
+	out_buf[out_index++] = 0x80;
+	out_buf[out_index++] = OLED_CMD_SET_COM_PIN_MAP;			// DA
+	if (dev->_height == 64) out_buf[out_index++] = 0x12;
+	if (dev->_height == 32) out_buf[out_index++] = 0x02;
+	out_buf[out_index++] = OLED_CMD_SET_CONTRAST;			// 81
+	out_buf[out_index++] = 0xFF;
+	out_buf[out_index++] = OLED_CMD_DISPLAY_RAM;				// A4
+	out_buf[out_index++] = OLED_CMD_SET_VCOMH_DESELCT;		// DB
+	out_buf[out_index++] = 0x40;
+	out_buf[out_index++] = OLED_CMD_SET_MEMORY_ADDR_MODE;	// 20
+	//out_buf[out_index++] = OLED_CMD_SET_HORI_ADDR_MODE;	// 00
+	out_buf[out_index++] = OLED_CMD_SET_PAGE_ADDR_MODE;		// 02
 	// Set Lower Column Start Address for Page Addressing Mode
-	i2c_master_write_byte(cmd, 0x00, true);
+	out_buf[out_index++] = 0x00;
 	// Set Higher Column Start Address for Page Addressing Mode
-	i2c_master_write_byte(cmd, 0x10, true);
-	i2c_master_write_byte(cmd, OLED_CMD_SET_CHARGE_PUMP, true);			// 8D
-	i2c_master_write_byte(cmd, 0x14, true);
-	i2c_master_write_byte(cmd, OLED_CMD_DEACTIVE_SCROLL, true);			// 2E
-	i2c_master_write_byte(cmd, OLED_CMD_DISPLAY_NORMAL, true);			// A6
-	i2c_master_write_byte(cmd, OLED_CMD_DISPLAY_ON, true);				// AF
-
-	i2c_master_stop(cmd);
-
-	esp_err_t res = i2c_master_cmd_begin(dev->_i2c_num, cmd, I2C_TICKS_TO_WAIT);
+	out_buf[out_index++] = 0x10;
+	out_buf[out_index++] = OLED_CMD_SET_CHARGE_PUMP;			// 8D
+	out_buf[out_index++] = 0x14;
+	out_buf[out_index++] = OLED_CMD_DEACTIVE_SCROLL;			// 2E
+	out_buf[out_index++] = OLED_CMD_DISPLAY_NORMAL;			// A6
+	out_buf[out_index++] = OLED_CMD_DISPLAY_ON;				// AF
+
+	esp_err_t res = i2c_write(dev, out_buf, out_index);
+	ssd1306_count_transfer(dev, out_index + 1, 0, res == ESP_OK);
 	if (res == ESP_OK) {
 		ESP_LOGI(TAG, "OLED configured successfully");
 	} else {
 		ESP_LOGE(TAG, "OLED configuration failed. code: 0x%.2X", res);
 	}
-	i2c_cmd_link_delete(cmd);
 }
 
 
 void i2c_display_image(SSD1306_t * dev, int page, int seg, uint8_t * images, int width) {
 	if (page >= dev->_pages) return;
 	if (seg >= dev->_width) return;
+	if (dev->_tx_buf == NULL) return;
+	if (width > dev->_width - seg) width = dev->_width - seg;
 
 	int _seg = seg + CONFIG_OFFSETX;
 	uint8_t columLow = _seg & 0x0F;
@@ -154,37 +189,126 @@ void i2c_display_image(SSD1306_t * dev, int page, int seg, uint8_t * images, int
 		_page = (dev->_pages - page) - 1;
 	}
 
-	i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-	i2c_master_start(cmd);
-	i2c_master_write_byte(cmd, (dev->_address << 1) | I2C_MASTER_WRITE, true);
-
-	i2c_master_write_byte(cmd, OLED_CONTROL_BYTE_CMD_STREAM, true);
+	// i2c_master_write_to_device builds its command link on the stack,
+	// so together with _tx_buf this path never touches the heap
+	uint8_t *out_buf = dev->_tx_buf;
+	int out_index = 0;
+	out_buf[out_index++] = OLED_CONTROL_BYTE_CMD_STREAM;
+	if (dev->_horizontal) {
+		// Return to Page Addressing Mode after a full frame flush
+		out_buf[out_index++] = OLED_CMD_SET_MEMORY_ADDR_MODE;	// 20
+		out_buf[out_index++] = OLED_CMD_SET_PAGE_ADDR_MODE;		// 02
+		dev->_horizontal = false;
+	}
 	// Set Lower Column Start Address for Page Addressing Mode
-	i2c_master_write_byte(cmd, (0x00 + columLow), true);
+	out_buf[out_index++] = (0x00 + columLow);
 	// Set Higher Column Start Address for Page Addressing Mode
-	i2c_master_write_byte(cmd, (0x10 + columHigh), true);
+	out_buf[out_index++] = (0x10 + columHigh);
 	// Set Page Start Address for Page Addressing Mode
-	i2c_master_write_byte(cmd, 0xB0 | _page, true);
+	out_buf[out_index++] = 0xB0 | _page;
 
-	i2c_master_stop(cmd);
-	esp_err_t res = i2c_master_cmd_begin(dev->_i2c_num, cmd, I2C_TICKS_TO_WAIT);
+	esp_err_t res = i2c_write(dev, out_buf, out_index);
+	ssd1306_count_transfer(dev, out_index + 1, 0, res == ESP_OK);
+	if (res != ESP_OK) {
+		ESP_LOGE(TAG, "Image command failed. code: 0x%.2X", res);
+	}
+
+	out_buf[0] = OLED_CONTROL_BYTE_DATA_STREAM;
+	ssd1306_copy_segs(dev, &out_buf[1], images, width);
+
+	res = i2c_write(dev, out_buf, width + 1);
+	ssd1306_count_transfer(dev, 2, width, res == ESP_OK);
 	if (res != ESP_OK) {
 		ESP_LOGE(TAG, "Image command failed. code: 0x%.2X", res);
 	}
-	i2c_cmd_link_delete(cmd);
+}
+
+// On a shared bus the frame goes out one page per transaction, so another device never
+// waits for more than one page. The panel keeps its address pointer between transactions.
+// out_buf holds header addressing bytes followed by the whole frame.
+static void i2c_shared_frame(SSD1306_t * dev, uint8_t * out_buf, int header) {
+	int index = 0;
+	int len = header + dev->_width;
+	for (int page=0; page<dev->_pages; page++) {
+		if (page > 0) {
+			// The last byte of the page just sent becomes the control byte of the next one
+			index = index + len - 1;
+			out_buf[index] = OLED_CONTROL_BYTE_DATA_STREAM;
+			len = dev->_width + 1;
+		}
+		esp_err_t res = dev->_i2cWrite(dev->_i2cCtx, &out_buf[index], len);
+		ssd1306_count_transfer(dev, len - dev->_width + 1, dev->_width, res == ESP_OK);
+		if (res != ESP_OK) {
+			ESP_LOGE(TAG, "Frame command failed. code: 0x%.2X", res);
+			return;
+		}
+	}
+}
+
+// Send the whole frame held in pages in one transaction using Horizontal Addressing Mode,
+// or one page per transaction on a shared bus. Single command control bytes let the data stream follow in the same transaction.
+void i2c_display_frame(SSD1306_t * dev, PAGE_t * pages) {
+	if (dev->_tx_buf == NULL) return;
+
+	uint8_t *out_buf = dev->_tx_buf;
+	int out_index = 0;
+	if (!dev->_horizontal) {
+		out_buf[out_index++] = OLED_CONTROL_BYTE_CMD_SINGLE;
+		out_buf[out_index++] = OLED_CMD_SET_MEMORY_ADDR_MODE;	// 20
+		out_buf[out_index++] = OLED_CONTROL_BYTE_CMD_SINGLE;
+		out_buf[out_index++] = OLED_CMD_SET_HORI_ADDR_MODE;		// 00
+		dev->_horizontal = true;
+	}
+	out_buf[out_index++] = OLED_CONTROL_BYTE_CMD_SINGLE;
+	out_buf[out_index++] = OLED_CMD_SET_COLUMN_RANGE;			// 21
+	out_buf[out_index++] = OLED_CONTROL_BYTE_CMD_SINGLE;
+	out_buf[out_index++] = CONFIG_OFFSETX;
+	out_buf[out_index++] = OLED_CONTROL_BYTE_CMD_SINGLE;
+	out_buf[out_index++] = CONFIG_OFFSETX + dev->_width - 1;
+	out_buf[out_index++] = OLED_CONTROL_BYTE_CMD_SINGLE;
+	out_buf[out_index++] = OLED_CMD_SET_PAGE_RANGE;				// 22
+	out_buf[out_index++] = OLED_CONTROL_BYTE_CMD_SINGLE;
+	out_buf[out_index++] = 0x00;
+	out_buf[out_index++] = OLED_CONTROL_BYTE_CMD_SINGLE;
+	out_buf[out_index++] = dev->_pages - 1;
+	out_buf[out_index++] = OLED_CONTROL_BYTE_DATA_STREAM;
+
+	// An upright full width frame is already one contiguous block, so it follows
+	// the addressing bytes in the same transaction without a copy into _tx_buf
+	int payload = dev->_pages * dev->_width;
+	const uint8_t *frame = pages[0]._segs;
+	if (dev->_flip || dev->_width != 128 || dev->_i2cWrite != NULL) {
+		frame = &out_buf[out_index];
+		int frame_index = out_index;
+		for (int page=0; page<dev->_pages; page++) {
+			int _page = page;
+			if (dev->_flip) {
+				_page = (dev->_pages - page) - 1;
+			}
+			ssd1306_copy_segs(dev, &out_buf[frame_index], pages[_page]._segs, dev->_width);
+			frame_index = frame_index + dev->_width;
+		}
+	}
 
-	cmd = i2c_cmd_link_create();
+	if (dev->_i2cWrite != NULL) {
+		i2c_shared_frame(dev, out_buf, out_index);
+		return;
+	}
+
+	// The command link lives on the stack like in i2c_master_write_to_device
+	uint8_t link_buf[I2C_LINK_RECOMMENDED_SIZE(2)] = { 0 };
+	i2c_cmd_handle_t cmd = i2c_cmd_link_create_static(link_buf, sizeof(link_buf));
 	i2c_master_start(cmd);
 	i2c_master_write_byte(cmd, (dev->_address << 1) | I2C_MASTER_WRITE, true);
-	i2c_master_write_byte(cmd, OLED_CONTROL_BYTE_DATA_STREAM, true);
-	i2c_master_write(cmd, images, width, true);
+	i2c_master_write(cmd, out_buf, out_index, true);
+	i2c_master_write(cmd, frame, payload, true);
 	i2c_master_stop(cmd);
-
-	res = i2c_master_cmd_begin(dev->_i2c_num, cmd, I2C_TICKS_TO_WAIT);
+	esp_err_t res = i2c_master_cmd_begin(dev->_i2c_num, cmd, I2C_TICKS_TO_WAIT);
+	i2c_cmd_link_delete_static(cmd);
+	ssd1306_count_transfer(dev, out_index + 1, payload, res == ESP_OK);
 	if (res != ESP_OK) {
-		ESP_LOGE(TAG, "Image command failed. code: 0x%.2X", res);
+		ESP_LOGE(TAG, "Frame command failed. code: 0x%.2X", res);
 	}
-	i2c_cmd_link_delete(cmd);
 }
 
 void i2c_contrast(SSD1306_t * dev, int contrast) {
@@ -192,99 +316,93 @@ void i2c_contrast(SSD1306_t * dev, int contrast) {
 	if (contrast < 0x0) _contrast = 0;
 	if (contrast > 0xFF) _contrast = 0xFF;
 
-	i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-	i2c_master_start(cmd);
-	i2c_master_write_byte(cmd, (dev->_address << 1) | I2C_MASTER_WRITE, true);
-	i2c_master_write_byte(cmd, OLED_CONTROL_BYTE_CMD_STREAM, true); // 00
-	i2c_master_write_byte(cmd, OLED_CMD_SET_CONTRAST, true); // 81
-	i2c_master_write_byte(cmd, _contrast, true);
-	i2c_master_stop(cmd);
+	uint8_t out_buf[3];
+	int out_index = 0;
+	out_buf[out_index++] = OLED_CONTROL_BYTE_CMD_STREAM; // 00
+	out_buf[out_index++] = OLED_CMD_SET_CONTRAST; // 81
+	out_buf[out_index++] = _contrast;
 
-	esp_err_t res = i2c_master_cmd_begin(dev->_i2c_num, cmd, I2C_TICKS_TO_WAIT);
+	esp_err_t res = i2c_write(dev, out_buf, out_index);
+	ssd1306_count_transfer(dev, out_index + 1, 0, res == ESP_OK);
 	if (res != ESP_OK) {
 		ESP_LOGE(TAG, "Contrast command failed. code: 0x%.2X", res);
 	}
-	i2c_cmd_link_delete(cmd);
 }
 
 
 void i2c_hardware_scroll(SSD1306_t * dev, ssd1306_scroll_type_t scroll) {
-	i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-	i2c_master_start(cmd);
-
-	i2c_master_write_byte(cmd, (dev->_address << 1) | I2C_MASTER_WRITE, true);
-	i2c_master_write_byte(cmd, OLED_CONTROL_BYTE_CMD_STREAM, true); // 00
+	uint8_t out_buf[11];
+	int out_index = 0;
+	out_buf[out_index++] = OLED_CONTROL_BYTE_CMD_STREAM; // 00
 
 	if (scroll == SCROLL_RIGHT) {
-		i2c_master_write_byte(cmd, OLED_CMD_HORIZONTAL_RIGHT, true); // 26
-		i2c_master_write_byte(cmd, 0x00, true); // Dummy byte
-		i2c_master_write_byte(cmd, 0x00, true); // Define start page address
-		i2c_master_write_byte(cmd, 0x07, true); // Frame frequency
-		i2c_master_write_byte(cmd, 0x07, true); // Define end page address
-		i2c_master_write_byte(cmd, 0x00, true); //
-		i2c_master_write_byte(cmd, 0xFF, true); //
-		i2c_master_write_byte(cmd, OLED_CMD_ACTIVE_SCROLL, true); // 2F
+		out_buf[out_index++] = OLED_CMD_HORIZONTAL_RIGHT; // 26
+		out_buf[out_index++] = 0x00; // Dummy byte
+		out_buf[out_index++] = 0x00; // Define start page address
+		out_buf[out_index++] = 0x07; // Frame frequency
+		out_buf[out_index++] = 0x07; // Define end page address
+		out_buf[out_index++] = 0x00; //
+		out_buf[out_index++] = 0xFF; //
+		out_buf[out_index++] = OLED_CMD_ACTIVE_SCROLL; // 2F
 	} 
 
 	if (scroll == SCROLL_LEFT) {
-		i2c_master_write_byte(cmd, OLED_CMD_HORIZONTAL_LEFT, true); // 27
-		i2c_master_write_byte(cmd, 0x00, true); // Dummy byte
-		i2c_master_write_byte(cmd, 0x00, true); // Define start page address
-		i2c_master_write_byte(cmd, 0x07, true); // Frame frequency
-		i2c_master_write_byte(cmd, 0x07, true); // Define end page address
-		i2c_master_write_byte(cmd, 0x00, true); //
-		i2c_master_write_byte(cmd, 0xFF, true); //
-		i2c_master_write_byte(cmd, OLED_CMD_ACTIVE_SCROLL, true); // 2F
+		out_buf[out_index++] = OLED_CMD_HORIZONTAL_LEFT; // 27
+		out_buf[out_index++] = 0x00; // Dummy byte
+		out_buf[out_index++] = 0x00; // Define start page address
+		out_buf[out_index++] = 0x07; // Frame frequency
+		out_buf[out_index++] = 0x07; // Define end page address
+		out_buf[out_index++] = 0x00; //
+		out_buf[out_index++] = 0xFF; //
+		out_buf[out_index++] = OLED_CMD_ACTIVE_SCROLL; // 2F
 	} 
 
 	if (scroll == SCROLL_DOWN) {
-		i2c_master_write_byte(cmd, OLED_CMD_CONTINUOUS_SCROLL, true); // 29
-		i2c_master_write_byte(cmd, 0x00, true); // Dummy byte
-		i2c_master_write_byte(cmd, 0x00, true); // Define start page address
-		i2c_master_write_byte(cmd, 0x07, true); // Frame frequency
-		//i2c_master_write_byte(cmd, 0x01, true); // Define end page address
-		i2c_master_write_byte(cmd, 0x00, true); // Define end page address
-		i2c_master_write_byte(cmd, 0x3F, true); // Vertical scrolling offset
-
-		i2c_master_write_byte(cmd, OLED_CMD_VERTICAL, true); // A3
-		i2c_master_write_byte(cmd, 0x00, true);
+		out_buf[out_index++] = OLED_CMD_CONTINUOUS_SCROLL; // 29
+		out_buf[out_index++] = 0x00; // Dummy byte
+		out_buf[out_index++] = 0x00; // Define start page address
+		out_buf[out_index++] = 0x07; // Frame frequency
+		//out_buf[out_index++] = 0x01; // Define end page address
+		out_buf[out_index++] = 0x00; // Define end page address
+		out_buf[out_index++] = 0x3F; // Vertical scrolling offset
+
+		out_buf[out_index++] = OLED_CMD_VERTICAL; // A3
+		out_buf[out_index++] = 0x00;
 		if (dev->_height == 64)
-		//i2c_master_write_byte(cmd, 0x7F, true);
-		i2c_master_write_byte(cmd, 0x40, true);
+		//out_buf[out_index++] = 0x7F;
+		out_buf[out_index++] = 0x40;
 		if (dev->_height == 32)
-		i2c_master_write_byte(cmd, 0x20, true);
-		i2c_master_write_byte(cmd, OLED_CMD_ACTIVE_SCROLL, true); // 2F
+		out_buf[out_index++] = 0x20;
+		out_buf[out_index++] = OLED_CMD_ACTIVE_SCROLL; // 2F
 	}
 
 	if (scroll == SCROLL_UP) {
-		i2c_master_write_byte(cmd, OLED_CMD_CONTINUOUS_SCROLL, true); // 29
-		i2c_master_write_byte(cmd, 0x00, true); // Dummy byte
-		i2c_master_write_byte(cmd, 0x00, true); // Define start page address
-		i2c_master_write_byte(cmd, 0x07, true); // Frame frequency
-		//i2c_master_write_byte(cmd, 0x01, true); // Define end page address
-		i2c_master_write_byte(cmd, 0x00, true); // Define end page address
-		i2c_master_write_byte(cmd, 0x01, true); // Vertical scrolling offset
-
-		i2c_master_write_byte(cmd, OLED_CMD_VERTICAL, true); // A3
-		i2c_master_write_byte(cmd, 0x00, true);
+		out_buf[out_index++] = OLED_CMD_CONTINUOUS_SCROLL; // 29
+		out_buf[out_index++] = 0x00; // Dummy byte
+		out_buf[out_index++] = 0x00; // Define start page address
+		out_buf[out_index++] = 0x07; // Frame frequency
+		//out_buf[out_index++] = 0x01; // Define end page address
+		out_buf[out_index++] = 0x00; // Define end page address
+		out_buf[out_index++] = 0x01; // Vertical scrolling offset
+
+		out_buf[out_index++] = OLED_CMD_VERTICAL; // A3
+		out_buf[out_index++] = 0x00;
 		if (dev->_height == 64)
-		//i2c_master_write_byte(cmd, 0x7F, true);
-		i2c_master_write_byte(cmd, 0x40, true);
+		//out_buf[out_index++] = 0x7F;
+		out_buf[out_index++] = 0x40;
 		if (dev->_height == 32)
-		i2c_master_write_byte(cmd, 0x20, true);
-		i2c_master_write_byte(cmd, OLED_CMD_ACTIVE_SCROLL, true); // 2F
+		out_buf[out_index++] = 0x20;
+		out_buf[out_index++] = OLED_CMD_ACTIVE_SCROLL; // 2F
 	}
 
 	if (scroll == SCROLL_STOP) {
-		i2c_master_write_byte(cmd, OLED_CMD_DEACTIVE_SCROLL, true); // 2E
+		out_buf[out_index++] = OLED_CMD_DEACTIVE_SCROLL; // 2E
 	}
 
-	i2c_master_stop(cmd);
-
-	esp_err_t res = i2c_master_cmd_begin(dev->_i2c_num, cmd, I2C_TICKS_TO_WAIT);
+	esp_err_t res = i2c_write(dev, out_buf, out_index);
+	ssd1306_count_transfer(dev, out_index + 1, 0, res == ESP_OK);
 	if (res != ESP_OK) {
 		ESP_LOGE(TAG, "Scroll command failed. code: 0x%.2X", res);
 	}
-	i2c_cmd_link_delete(cmd);
 }
 
@@ -18,9 +18,23 @@
 #define I2C_NUM I2C_NUM_0 // if spi is selected
 #endif
 
-#define I2C_MASTER_FREQ_HZ 400000 // I2C clock of SSD1306 can run at 400 kHz max.
+#define I2C_MASTER_FREQ_HZ 400000 // I2C clock of SSD1306 can run at 400 kHz max. Default of i2c_clock_speed
 #define I2C_TICKS_TO_WAIT 100	  // Maximum ticks to wait before issuing a timeout.
 
+static int i2c_clock_speed_hz = I2C_MASTER_FREQ_HZ;
+
+// Set the SCL frequency used by the next i2c_master_init or i2c_bus_add
+void i2c_clock_speed(int speed) {
+	ESP_LOGI(TAG, "I2C clock speed=%d kHz", speed/1000);
+	i2c_clock_speed_hz = speed;
+}
+
+// One write transaction, through the shared bus writer when i2c_shared_add was used
+static esp_err_t i2c_write(SSD1306_t * dev, const uint8_t * buf, size_t len) {
+	if (dev->_i2cWrite != NULL) return dev->_i2cWrite(dev->_i2cCtx, buf, len);
+	return i2c_master_transmit(dev->_i2c_dev_handle, buf, len, I2C_TICKS_TO_WAIT);
+}
+
 void i2c_master_init(SSD1306_t * dev, int16_t sda, int16_t scl, int16_t reset)
 {
 	ESP_LOGI(TAG, "New i2c driver is used");
@@ -38,7 +52,7 @@ void i2c_master_init(SSD1306_t * dev, int16_t sda, int16_t scl, int16_t reset)
 	i2c_device_config_t dev_cfg = {
 		.dev_addr_length = I2C_ADDR_BIT_LEN_7,
 		.device_address = I2C_ADDRESS,
-		.scl_speed_hz = I2C_MASTER_FREQ_HZ,
+		.scl_speed_hz = i2c_clock_speed_hz,
 	};
 	i2c_master_dev_handle_t i2c_dev_handle;
 	ESP_ERROR_CHECK(i2c_master_bus_add_device(bus_handle, &dev_cfg, &i2c_dev_handle));
@@ -55,6 +69,7 @@ void i2c_master_init(SSD1306_t * dev, int16_t sda, int16_t scl, int16_t reset)
 	dev->_address = I2C_ADDRESS;
 	dev->_flip = false;
 	dev->_i2c_num = I2C_NUM;
+	dev->_i2cWrite = NULL;
 	dev->_i2c_dev_handle = i2c_dev_handle;
 }
 
@@ -78,7 +93,7 @@ void i2c_bus_add(SSD1306_t * dev, i2c_master_bus_handle_t bus_handle, i2c_port_t
 	i2c_device_config_t dev_cfg = {
 		.dev_addr_length = I2C_ADDR_BIT_LEN_7,
 		.device_address = I2C_ADDRESS,
-		.scl_speed_hz = I2C_MASTER_FREQ_HZ,
+		.scl_speed_hz = i2c_clock_speed_hz,
 	};
 	i2c_master_dev_handle_t i2c_dev_handle;
 	ESP_ERROR_CHECK(i2c_master_bus_add_device(bus_handle, &dev_cfg, &i2c_dev_handle));
@@ -95,9 +110,31 @@ void i2c_bus_add(SSD1306_t * dev, i2c_master_bus_handle_t bus_handle, i2c_port_t
 	dev->_address = I2C_ADDRESS;
 	dev->_flip = false;
 	dev->_i2c_num = i2c_num;
+	dev->_i2cWrite = NULL;
 	dev->_i2c_dev_handle = i2c_dev_handle;
 }
 
+// Attach the panel to a bus owned by someone else, e.g. a bus manager that arbitrates
+// it between several devices. Every transaction goes through write(ctx, ...).
+void i2c_shared_add(SSD1306_t * dev, i2c_port_t i2c_num, ssd1306_i2c_write_t write, void * ctx, int16_t reset)
+{
+	ESP_LOGI(TAG, "Shared i2c bus is used");
+
+	if (reset >= 0) {
+		gpio_reset_pin(reset);
+		gpio_set_direction(reset, GPIO_MODE_OUTPUT);
+		gpio_set_level(reset, 0);
+		vTaskDelay(50 / portTICK_PERIOD_MS);
+		gpio_set_level(reset, 1);
+	}
+
+	dev->_address = I2C_ADDRESS;
+	dev->_flip = false;
+	dev->_i2c_num = i2c_num;
+	dev->_i2cWrite = write;
+	dev->_i2cCtx = ctx;
+}
+
 void i2c_init(SSD1306_t * dev, int width, int height) {
 	dev->_width = width;
 	dev->_height = height;
@@ -146,7 +183,8 @@ void i2c_init(SSD1306_t * dev, int width, int height) {
 	out_buf[out_index++] = OLED_CMD_DISPLAY_ON;				// AF
 
 	esp_err_t res;
-	res = i2c_master_transmit(dev->_i2c_dev_handle, out_buf, out_index, I2C_TICKS_TO_WAIT);
+	res = i2c_write(dev, out_buf, out_index);
+	ssd1306_count_transfer(dev, out_index + 1, 0, res == ESP_OK);
 	if (res == ESP_OK) {
 		ESP_LOGI(TAG, "OLED configured successfully");
 	} else {
@@ -158,6 +196,8 @@ void i2c_init(SSD1306_t * dev, int width, int height) {
 void i2c_display_image(SSD1306_t * dev, int page, int seg, uint8_t * images, int width) {
 	if (page >= dev->_pages) return;
 	if (seg >= dev->_width) return;
+	if (dev->_tx_buf == NULL) return;
+	if (width > dev->_width - seg) width = dev->_width - seg;
 
 	int _seg = seg + CONFIG_OFFSETX;
 	uint8_t columLow = _seg & 0x0F;
@@ -168,14 +208,15 @@ void i2c_display_image(SSD1306_t * dev, int page, int seg, uint8_t * images, int
 		_page = (dev->_pages - page) - 1;
 	}
 
-	uint8_t *out_buf;
-	out_buf = malloc(width < 4 ? 4 : width + 1);
-	if (out_buf == NULL) {
-		ESP_LOGE(TAG, "malloc fail");
-		return;
-	}
+	uint8_t *out_buf = dev->_tx_buf;
 	int out_index = 0;
 	out_buf[out_index++] = OLED_CONTROL_BYTE_CMD_STREAM;
+	if (dev->_horizontal) {
+		// Return to Page Addressing Mode after a full frame flush
+		out_buf[out_index++] = OLED_CMD_SET_MEMORY_ADDR_MODE;	// 20
+		out_buf[out_index++] = OLED_CMD_SET_PAGE_ADDR_MODE;		// 02
+		dev->_horizontal = false;
+	}
 	// Set Lower Column Start Address for Page Addressing Mode
 	out_buf[out_index++] = (0x00 + columLow);
 	// Set Higher Column Start Address for Page Addressing Mode
@@ -184,17 +225,88 @@ void i2c_display_image(SSD1306_t * dev, int page, int seg, uint8_t * images, int
 	out_buf[out_index++] = 0xB0 | _page;
 
 	esp_err_t res;
-	res = i2c_master_transmit(dev->_i2c_dev_handle, out_buf, out_index, I2C_TICKS_TO_WAIT);
+	res = i2c_write(dev, out_buf, out_index);
+	ssd1306_count_transfer(dev, out_index + 1, 0, res == ESP_OK);
 	if (res != ESP_OK)
 		ESP_LOGE(TAG, "Could not write to device [0x%02x at %d]: %d (%s)", dev->_address, dev->_i2c_num, res, esp_err_to_name(res));
 
 	out_buf[0] = OLED_CONTROL_BYTE_DATA_STREAM;
-	memcpy(&out_buf[1], images, width);
+	ssd1306_copy_segs(dev, &out_buf[1], images, width);
+
+	res = i2c_write(dev, out_buf, width + 1);
+	ssd1306_count_transfer(dev, 2, width, res == ESP_OK);
+	if (res != ESP_OK)
+		ESP_LOGE(TAG, "Could not write to device [0x%02x at %d]: %d (%s)", dev->_address, dev->_i2c_num, res, esp_err_to_name(res));
+}
+
+// On a shared bus the frame goes out one page per transaction, so another device never
+// waits for more than one page. The panel keeps its address pointer between transactions.
+// out_buf holds header addressing bytes followed by the whole frame.
+static void i2c_shared_frame(SSD1306_t * dev, uint8_t * out_buf, int header) {
+	int index = 0;
+	int len = header + dev->_width;
+	for (int page=0; page<dev->_pages; page++) {
+		if (page > 0) {
+			// The last byte of the page just sent becomes the control byte of the next one
+			index = index + len - 1;
+			out_buf[index] = OLED_CONTROL_BYTE_DATA_STREAM;
+			len = dev->_width + 1;
+		}
+		esp_err_t res = dev->_i2cWrite(dev->_i2cCtx, &out_buf[index], len);
+		ssd1306_count_transfer(dev, len - dev->_width + 1, dev->_width, res == ESP_OK);
+		if (res != ESP_OK) {
+			ESP_LOGE(TAG, "Frame command failed. code: 0x%.2X", res);
+			return;
+		}
+	}
+}
+
+// Send the whole frame held in pages in one transaction using Horizontal Addressing Mode,
+// or one page per transaction on a shared bus. Single command control bytes let the data stream follow in the same transaction.
+void i2c_display_frame(SSD1306_t * dev, PAGE_t * pages) {
+	if (dev->_tx_buf == NULL) return;
+
+	uint8_t *out_buf = dev->_tx_buf;
+	int out_index = 0;
+	if (!dev->_horizontal) {
+		out_buf[out_index++] = OLED_CONTROL_BYTE_CMD_SINGLE;
+		out_buf[out_index++] = OLED_CMD_SET_MEMORY_ADDR_MODE;	// 20
+		out_buf[out_index++] = OLED_CONTROL_BYTE_CMD_SINGLE;
+		out_buf[out_index++] = OLED_CMD_SET_HORI_ADDR_MODE;		// 00
+		dev->_horizontal = true;
+	}
+	out_buf[out_index++] = OLED_CONTROL_BYTE_CMD_SINGLE;
+	out_buf[out_index++] = OLED_CMD_SET_COLUMN_RANGE;			// 21
+	out_buf[out_index++] = OLED_CONTROL_BYTE_CMD_SINGLE;
+	out_buf[out_index++] = CONFIG_OFFSETX;
+	out_buf[out_index++] = OLED_CONTROL_BYTE_CMD_SINGLE;
+	out_buf[out_index++] = CONFIG_OFFSETX + dev->_width - 1;
+	out_buf[out_index++] = OLED_CONTROL_BYTE_CMD_SINGLE;
+	out_buf[out_index++] = OLED_CMD_SET_PAGE_RANGE;				// 22
+	out_buf[out_index++] = OLED_CONTROL_BYTE_CMD_SINGLE;
+	out_buf[out_index++] = 0x00;
+	out_buf[out_index++] = OLED_CONTROL_BYTE_CMD_SINGLE;
+	out_buf[out_index++] = dev->_pages - 1;
+	out_buf[out_index++] = OLED_CONTROL_BYTE_DATA_STREAM;
+	for (int page=0; page<dev->_pages; page++) {
+		int _page = page;
+		if (dev->_flip) {
+			_page = (dev->_pages - page) - 1;
+		}
+		ssd1306_copy_segs(dev, &out_buf[out_index], pages[_page]._segs, dev->_width);
+		out_index = out_index + dev->_width;
+	}
+
+	int payload = dev->_pages * dev->_width;
+	if (dev->_i2cWrite != NULL) {
+		i2c_shared_frame(dev, out_buf, out_index - payload);
+		return;
+	}
 
-	res = i2c_master_transmit(dev->_i2c_dev_handle, out_buf, width + 1, I2C_TICKS_TO_WAIT);
+	esp_err_t res = i2c_write(dev, out_buf, out_index);
+	ssd1306_count_transfer(dev, out_index - payload + 1, payload, res == ESP_OK);
 	if (res != ESP_OK)
 		ESP_LOGE(TAG, "Could not write to device [0x%02x at %d]: %d (%s)", dev->_address, dev->_i2c_num, res, esp_err_to_name(res));
-	free(out_buf);
 }
 
 void i2c_contrast(SSD1306_t * dev, int contrast) {
@@ -208,7 +320,8 @@ void i2c_contrast(SSD1306_t * dev, int contrast) {
 	out_buf[out_index++] = OLED_CMD_SET_CONTRAST; // 81
 	out_buf[out_index++] = _contrast;
 
-	esp_err_t res = i2c_master_transmit(dev->_i2c_dev_handle, out_buf, 3, I2C_TICKS_TO_WAIT);
+	esp_err_t res = i2c_write(dev, out_buf, 3);
+	ssd1306_count_transfer(dev, 4, 0, res == ESP_OK);
 	if (res != ESP_OK)
 		ESP_LOGE(TAG, "Could not write to device [0x%02x at %d]: %d (%s)", dev->_address, dev->_i2c_num, res, esp_err_to_name(res));
 }
@@ -283,7 +396,8 @@ void i2c_hardware_scroll(SSD1306_t * dev, ssd1306_scroll_type_t scroll) {
 		out_buf[out_index++] = OLED_CMD_DEACTIVE_SCROLL; // 2E
 	}
 
-	esp_err_t res = i2c_master_transmit(dev->_i2c_dev_handle, out_buf, out_index, I2C_TICKS_TO_WAIT);
+	esp_err_t res = i2c_write(dev, out_buf, out_index);
+	ssd1306_count_transfer(dev, out_index + 1, 0, res == ESP_OK);
 	if (res != ESP_OK)
 		ESP_LOGE(TAG, "Could not write to device [0x%02x at %d]: %d (%s)", dev->_address, dev->_i2c_num, res, esp_err_to_name(res));
 }
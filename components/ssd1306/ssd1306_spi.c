@@ -4,6 +4,7 @@
 #include "freertos/task.h"
 #include "driver/spi_master.h"
 #include "driver/gpio.h"
+#include "esp_attr.h"
 #include "esp_log.h"
 
 #include "ssd1306.h"
@@ -21,9 +22,22 @@
 #define SPI_COMMAND_MODE 0
 #define SPI_DATA_MODE 1
 #define SPI_DEFAULT_FREQUENCY 1000000; // 1MHz
+#define SPI_QUEUE_SIZE 2 // Command and data transaction of one write
+
+// DC pin and level for spi_pre_transfer_callback, packed into spi_transaction_t.user.
+// Bit 1 is set so that a NULL user (blocking writes) leaves DC alone.
+#define SPI_TRANS_USER(dc, mode) ((void *)(intptr_t)(((dc) << 2) | 0x02 | (mode)))
 
 int clock_speed_hz = SPI_DEFAULT_FREQUENCY;
 
+// Set DC for a queued transaction right before it goes on the bus
+static void IRAM_ATTR spi_pre_transfer_callback(spi_transaction_t *t)
+{
+	intptr_t user = (intptr_t)t->user;
+	if (user == 0) return;
+	gpio_set_level(user >> 2, user & 0x01);
+}
+
 void spi_clock_speed(int speed) {
 	ESP_LOGI(TAG, "SPI clock speed=%d MHz", speed/1000000);
 	clock_speed_hz = speed;
@@ -69,7 +83,8 @@ void spi_master_init(SSD1306_t * dev, int16_t mosi, int16_t sclk, int16_t cs, in
 	//devcfg.clock_speed_hz = SPI_DEFAULT_FREQUENCY;
 	devcfg.clock_speed_hz = clock_speed_hz;
 	devcfg.spics_io_num = cs;
-	devcfg.queue_size = 1;
+	devcfg.queue_size = SPI_QUEUE_SIZE;
+	devcfg.pre_cb = spi_pre_transfer_callback;
 
 	spi_device_handle_t spi_device_handle;
 	ret = spi_bus_add_device( HOST_ID, &devcfg, &spi_device_handle);
@@ -125,7 +140,8 @@ void spi_device_add(SSD1306_t * dev, int16_t cs, int16_t dc, int16_t reset)
 	//devcfg.clock_speed_hz = SPI_DEFAULT_FREQUENCY;
 	devcfg.clock_speed_hz = clock_speed_hz;
 	devcfg.spics_io_num = cs;
-	devcfg.queue_size = 1;
+	devcfg.queue_size = SPI_QUEUE_SIZE;
+	devcfg.pre_cb = spi_pre_transfer_callback;
 
 	spi_device_handle_t spi_device_handle;
 	ret = spi_bus_add_device( HOST_ID, &devcfg, &spi_device_handle);
@@ -147,7 +163,7 @@ bool spi_master_write_byte(spi_device_handle_t SPIHandle, const uint8_t* Data, s
 		memset( &SPITransaction, 0, sizeof( spi_transaction_t ) );
 		SPITransaction.length = DataLength * 8;
 		SPITransaction.tx_buffer = Data;
-		spi_device_transmit( SPIHandle, &SPITransaction );
+		return spi_device_transmit( SPIHandle, &SPITransaction ) == ESP_OK;
 	}
 
 	return true;
@@ -158,13 +174,51 @@ bool spi_master_write_command(SSD1306_t * dev, uint8_t Command )
 	static uint8_t CommandByte = 0;
 	CommandByte = Command;
 	gpio_set_level( dev->_dc, SPI_COMMAND_MODE );
-	return spi_master_write_byte( dev->_spi_device_handle, &CommandByte, 1 );
+	bool ok = spi_master_write_byte( dev->_spi_device_handle, &CommandByte, 1 );
+	ssd1306_count_transfer(dev, 1, 0, ok);
+	return ok;
 }
 
 bool spi_master_write_data(SSD1306_t * dev, const uint8_t* Data, size_t DataLength )
 {
 	gpio_set_level( dev->_dc, SPI_DATA_MODE );
-	return spi_master_write_byte( dev->_spi_device_handle, Data, DataLength );
+	bool ok = spi_master_write_byte( dev->_spi_device_handle, Data, DataLength );
+	ssd1306_count_transfer(dev, 0, DataLength, ok);
+	return ok;
+}
+
+// Queue a command transaction and a data transaction back to back and wait for both.
+// DC is switched by spi_pre_transfer_callback, so the CPU is free while DMA runs.
+static void spi_master_queue_write(SSD1306_t * dev, const uint8_t * Commands, size_t CommandLength, const uint8_t * Data, size_t DataLength)
+{
+	spi_transaction_t SPITransaction[SPI_QUEUE_SIZE];
+	memset( SPITransaction, 0, sizeof( SPITransaction ) );
+	SPITransaction[0].length = CommandLength * 8;
+	SPITransaction[0].tx_buffer = Commands;
+	SPITransaction[0].user = SPI_TRANS_USER( dev->_dc, SPI_COMMAND_MODE );
+	SPITransaction[1].length = DataLength * 8;
+	SPITransaction[1].tx_buffer = Data;
+	SPITransaction[1].user = SPI_TRANS_USER( dev->_dc, SPI_DATA_MODE );
+
+	int queued = 0;
+	bool ok = true;
+	for (int i=0; i<SPI_QUEUE_SIZE; i++) {
+		if (SPITransaction[i].length == 0) continue;
+		esp_err_t ret = spi_device_queue_trans( dev->_spi_device_handle, &SPITransaction[i], portMAX_DELAY );
+		if (ret != ESP_OK) {
+			ESP_LOGE(TAG, "spi_device_queue_trans=%d", ret);
+			ok = false;
+			break;
+		}
+		queued++;
+	}
+
+	spi_transaction_t *rtrans;
+	for (int i=0; i<queued; i++) {
+		if (spi_device_get_trans_result( dev->_spi_device_handle, &rtrans, portMAX_DELAY ) != ESP_OK) ok = false;
+	}
+	ssd1306_count_transfer(dev, CommandLength, 0, ok);
+	if (DataLength > 0) ssd1306_count_transfer(dev, 0, DataLength, ok);
 }
 
 
@@ -218,6 +272,7 @@ void spi_display_image(SSD1306_t * dev, int page, int seg, uint8_t * images, int
 {
 	if (page >= dev->_pages) return;
 	if (seg >= dev->_width) return;
+	if (dev->_flip && dev->_tx_buf == NULL) return;
 
 	int _seg = seg + CONFIG_OFFSETX;
 	uint8_t columLow = _seg & 0x0F;
@@ -228,15 +283,66 @@ void spi_display_image(SSD1306_t * dev, int page, int seg, uint8_t * images, int
 		_page = (dev->_pages - page) - 1;
 	}
 
+	uint8_t commands[5];
+	int cmd_index = 0;
+	if (dev->_horizontal) {
+		// Return to Page Addressing Mode after a full frame flush
+		commands[cmd_index++] = OLED_CMD_SET_MEMORY_ADDR_MODE;	// 20
+		commands[cmd_index++] = OLED_CMD_SET_PAGE_ADDR_MODE;	// 02
+		dev->_horizontal = false;
+	}
 	// Set Lower Column Start Address for Page Addressing Mode
-	spi_master_write_command(dev, (0x00 + columLow));
+	commands[cmd_index++] = (0x00 + columLow);
 	// Set Higher Column Start Address for Page Addressing Mode
-	spi_master_write_command(dev, (0x10 + columHigh));
+	commands[cmd_index++] = (0x10 + columHigh);
 	// Set Page Start Address for Page Addressing Mode
-	spi_master_write_command(dev, 0xB0 | _page);
+	commands[cmd_index++] = 0xB0 | _page;
 
-	spi_master_write_data(dev, images, width);
+	// An upside down panel needs the bits of every byte reversed, so send a copy
+	if (dev->_flip) {
+		ssd1306_copy_segs(dev, dev->_tx_buf, images, width);
+		images = dev->_tx_buf;
+	}
+	spi_master_queue_write(dev, commands, cmd_index, images, width);
+}
 
+// Send the whole frame held in pages as one queued DMA write using Horizontal Addressing Mode.
+// The addressing commands follow the frame data in _tx_buf, which is DMA capable.
+void spi_display_frame(SSD1306_t * dev, PAGE_t * pages)
+{
+	if (dev->_tx_buf == NULL) return;
+
+	uint8_t *commands = &dev->_tx_buf[dev->_pages * dev->_width];
+	int cmd_index = 0;
+	if (!dev->_horizontal) {
+		commands[cmd_index++] = OLED_CMD_SET_MEMORY_ADDR_MODE;	// 20
+		commands[cmd_index++] = OLED_CMD_SET_HORI_ADDR_MODE;	// 00
+		dev->_horizontal = true;
+	}
+	commands[cmd_index++] = OLED_CMD_SET_COLUMN_RANGE;			// 21
+	commands[cmd_index++] = CONFIG_OFFSETX;
+	commands[cmd_index++] = CONFIG_OFFSETX + dev->_width - 1;
+	commands[cmd_index++] = OLED_CMD_SET_PAGE_RANGE;			// 22
+	commands[cmd_index++] = 0x00;
+	commands[cmd_index++] = dev->_pages - 1;
+
+	// An upright full width frame is one contiguous DMA capable block and goes out as is
+	int length = dev->_pages * dev->_width;
+	if (!dev->_flip && dev->_width == 128) {
+		spi_master_queue_write(dev, commands, cmd_index, pages[0]._segs, length);
+		return;
+	}
+
+	int out_index = 0;
+	for (int page=0; page<dev->_pages; page++) {
+		int _page = page;
+		if (dev->_flip) {
+			_page = (dev->_pages - page) - 1;
+		}
+		ssd1306_copy_segs(dev, &dev->_tx_buf[out_index], pages[_page]._segs, dev->_width);
+		out_index = out_index + dev->_width;
+	}
+	spi_master_queue_write(dev, commands, cmd_index, dev->_tx_buf, length);
 }
 
 void spi_contrast(SSD1306_t * dev, int contrast) {
@@ -0,0 +1,256 @@
+#!/usr/bin/env python3
+"""
+fontconv.py - convert a bitmap font to a proportional ssd1306_font_t
+
+Sources:
+  *.bdf              X11/Adobe Glyph Bitmap Distribution Format
+  font8x8_basic.h    the transposed 8x8 table shipped with this component;
+                     blank columns are trimmed so the glyphs become proportional
+
+Glyph columns are cropped to their ink and bit-packed column by column,
+LSB at the top, with every glyph starting on a byte boundary. See
+ssd1306_font.h for the layout the renderer expects.
+
+Code points first..last form the dense part of the glyph index. Glyphs
+outside that range taken from --extra BDF files (e.g. the Latin-1
+supplement) are appended and reached through the sparse index.
+
+Usage:
+  fontconv.py SOURCE NAME [--first 32] [--last 126] [--spacing 1]
+              [--space-width 3] [--scale 1] [--extra FILE.bdf ...]
+              [-o OUTPUT.c]
+"""
+
+import argparse
+import os
+import re
+import sys
+
+
+class Glyph:
+	def __init__(self, code, columns, xoffset, advance):
+		self.code = code
+		self.columns = columns		# list of ints, bit 0 is the top row
+		self.xoffset = xoffset
+		self.advance = advance
+
+
+def load_font8x8(path):
+	"""Return (height, {code: [8 column bytes]}) from font8x8_basic.h"""
+	pattern = re.compile(r'\{\s*((?:0x[0-9A-Fa-f]{2}\s*,?\s*){8})\}\s*,?\s*//\s*U\+([0-9A-Fa-f]{4})')
+	cells = {}
+	with open(path) as f:
+		for line in f:
+			m = pattern.search(line)
+			if m is None:
+				continue
+			columns = [int(v, 16) for v in re.findall(r'0x[0-9A-Fa-f]{2}', m.group(1))]
+			cells[int(m.group(2), 16)] = columns
+	return 8, cells
+
+
+def load_bdf(path):
+	"""Return (height, {code: (columns, xoffset, advance)}) from a BDF file"""
+	ascent = descent = None
+	glyphs = {}
+	with open(path) as f:
+		lines = iter(f.read().splitlines())
+	for line in lines:
+		words = line.split()
+		if not words:
+			continue
+		if words[0] == 'FONT_ASCENT':
+			ascent = int(words[1])
+		elif words[0] == 'FONT_DESCENT':
+			descent = int(words[1])
+		elif words[0] == 'STARTCHAR':
+			code = None
+			advance = 0
+			bbx = (0, 0, 0, 0)
+			rows = []
+			for line in lines:
+				words = line.split()
+				if not words:
+					continue
+				if words[0] == 'ENCODING':
+					code = int(words[1])
+				elif words[0] == 'DWIDTH':
+					advance = int(words[1])
+				elif words[0] == 'BBX':
+					bbx = tuple(int(v) for v in words[1:5])
+				elif words[0] == 'BITMAP':
+					for line in lines:
+						if line.strip() == 'ENDCHAR':
+							break
+						rows.append(int(line.strip(), 16))
+					break
+			if code is None or code < 0:
+				continue
+			width, height, xoff, yoff = bbx
+			row_bits = ((width + 7) // 8) * 8
+			# Top row of the bounding box counted from the top of the cell
+			top = ascent - (yoff + height)
+			columns = []
+			for x in range(width):
+				column = 0
+				for y, row in enumerate(rows):
+					if row & (1 << (row_bits - 1 - x)) and 0 <= top + y < ascent + descent:
+						column |= 1 << (top + y)
+				columns.append(column)
+			glyphs[code] = (columns, xoff, advance)
+	if ascent is None or descent is None:
+		sys.exit("%s: FONT_ASCENT/FONT_DESCENT missing" % path)
+	return ascent + descent, glyphs
+
+
+def crop(columns):
+	"""Strip blank columns on both sides, returning (columns, left)"""
+	left = 0
+	while left < len(columns) and columns[left] == 0:
+		left += 1
+	right = len(columns)
+	while right > left and columns[right - 1] == 0:
+		right -= 1
+	return columns[left:right], left
+
+
+def scale_columns(columns, height, scale):
+	out = []
+	for column in columns:
+		wide = 0
+		for y in range(height):
+			if column & (1 << y):
+				wide |= ((1 << scale) - 1) << (y * scale)
+		out.extend([wide] * scale)
+	return out
+
+
+def pack(columns, height):
+	"""Bit-pack columns LSB first, padded to a whole byte"""
+	bits = []
+	for column in columns:
+		for y in range(height):
+			bits.append((column >> y) & 1)
+	data = bytearray((len(bits) + 7) // 8)
+	for i, bit in enumerate(bits):
+		if bit:
+			data[i // 8] |= 1 << (i % 8)
+	return bytes(data)
+
+
+def main():
+	parser = argparse.ArgumentParser(description="Convert a bitmap font to an ssd1306_font_t C source")
+	parser.add_argument('source', help="BDF file or font8x8_basic.h")
+	parser.add_argument('name', help="C identifier of the font, e.g. font_prop8")
+	parser.add_argument('--first', type=lambda v: int(v, 0), default=0x20)
+	parser.add_argument('--last', type=lambda v: int(v, 0), default=0x7E)
+	parser.add_argument('--spacing', type=int, default=1, help="blank columns after each font8x8 glyph")
+	parser.add_argument('--space-width', type=int, default=3, help="advance of font8x8 glyphs without ink")
+	parser.add_argument('--scale', type=int, default=1, help="integer upscale factor")
+	parser.add_argument('--extra', action='append', default=[], help="BDF file with glyphs for the sparse index")
+	parser.add_argument('-o', '--output', help="output file, default NAME.c")
+	args = parser.parse_args()
+
+	trim = args.source.endswith('.h')
+	if trim:
+		height, cells = load_font8x8(args.source)
+		cells = dict((code, (columns, 0, 0)) for code, columns in cells.items())
+	else:
+		height, cells = load_bdf(args.source)
+	sparse = []
+	for extra in args.extra:
+		extra_height, extra_cells = load_bdf(extra)
+		if extra_height != height:
+			sys.exit("%s: %d pixels high, %s is %d" % (extra, extra_height, args.source, height))
+		for code, cell in sorted(extra_cells.items()):
+			if args.first <= code <= args.last:
+				continue
+			cells[code] = cell
+			sparse.append(code)
+
+	def make_glyph(code):
+		columns, xoff, advance = cells.get(code, ([], 0, 0))
+		columns, left = crop(columns)
+		if trim:
+			# Match the trimmed font8x8 glyphs: no bearing, fixed spacing
+			advance = len(columns) + args.spacing if columns else args.space_width
+			return Glyph(code, columns, 0, advance)
+		return Glyph(code, columns, xoff + left, advance)
+
+	glyphs = [make_glyph(code) for code in range(args.first, args.last + 1)]
+	glyphs += [make_glyph(code) for code in sparse]
+	if len(glyphs) > 0xFF:
+		sys.exit("%d glyphs exceed the 8 bit sparse index" % len(glyphs))
+
+	if args.scale > 1:
+		for glyph in glyphs:
+			glyph.columns = scale_columns(glyph.columns, height, args.scale)
+			glyph.xoffset *= args.scale
+			glyph.advance *= args.scale
+		height *= args.scale
+	if height > 32:
+		sys.exit("font height %d exceeds 32 pixels" % height)
+
+	bitmap = bytearray()
+	index = []
+	for glyph in glyphs:
+		index.append((len(bitmap), len(glyph.columns), glyph.xoffset, glyph.advance))
+		bitmap += pack(glyph.columns, height)
+	if len(bitmap) > 0xFFFF:
+		sys.exit("bitmap of %d bytes exceeds the 16 bit glyph offset" % len(bitmap))
+
+	output = args.output or (args.name + '.c')
+	with open(output, 'w') as f:
+		f.write("/*\n")
+		f.write(" * %s.c\n" % args.name)
+		f.write(" *\n")
+		f.write(" * Generated by tools/fontconv.py from %s. Do not edit.\n" % os.path.basename(args.source))
+		f.write(" * %d pixels high, U+%04X - U+%04X, %d bytes of glyph data.\n" % (height, args.first, args.last, len(bitmap)))
+		if sparse:
+			f.write(" * Sparse: %s.\n" % ", ".join("U+%04X" % code for code in sparse))
+		for extra in args.extra:
+			f.write(" * Extra glyphs from %s.\n" % os.path.basename(extra))
+		f.write(" */\n\n")
+		f.write('#include "ssd1306_font.h"\n\n')
+		f.write("static const uint8_t %s_bitmap[] = {\n" % args.name)
+		for glyph, (offset, width, xoffset, advance) in zip(glyphs, index):
+			data = bitmap[offset:offset + (width * height + 7) // 8]
+			label = chr(glyph.code) if 0x20 < glyph.code < 0x7F and glyph.code != 0x5C else ''
+			if glyph.code > 0xA0:
+				label = chr(glyph.code)
+			if not data:
+				continue
+			f.write("\t%s,\t// U+%04X %s\n" % (", ".join("0x%02X" % b for b in data), glyph.code, label))
+		if not bitmap:
+			f.write("\t0x00\n")
+		f.write("};\n\n")
+		f.write("static const ssd1306_glyph_t %s_glyphs[] = {\n" % args.name)
+		for glyph, (offset, width, xoffset, advance) in zip(glyphs, index):
+			f.write("\t{ %5d, %2d, %2d, %2d },\t// U+%04X\n" % (offset, width, xoffset, advance, glyph.code))
+		f.write("};\n\n")
+		if sparse:
+			# Position in glyphs for each code point of the sparse range, 0 if the font lacks it
+			ext_first = sparse[0]
+			ext_last = sparse[-1]
+			positions = [0] * (ext_last - ext_first + 1)
+			for n, code in enumerate(sparse):
+				positions[code - ext_first] = args.last - args.first + 1 + n
+			f.write("static const uint8_t %s_ext_index[] = {\n" % args.name)
+			for row in range(0, len(positions), 16):
+				f.write("\t%s,\t// U+%04X\n" % (", ".join("%3d" % v for v in positions[row:row + 16]), ext_first + row))
+			f.write("};\n\n")
+		f.write("const ssd1306_font_t %s = {\n" % args.name)
+		f.write("\t.height = %d,\n" % height)
+		f.write("\t.first = 0x%04X,\n" % args.first)
+		f.write("\t.last = 0x%04X,\n" % args.last)
+		f.write("\t.glyphs = %s_glyphs,\n" % args.name)
+		f.write("\t.bitmap = %s_bitmap,\n" % args.name)
+		if sparse:
+			f.write("\t.ext_first = 0x%04X,\n" % ext_first)
+			f.write("\t.ext_last = 0x%04X,\n" % ext_last)
+			f.write("\t.ext_index = %s_ext_index,\n" % args.name)
+		f.write("};\n")
+
+
+if __name__ == '__main__':
+	main()
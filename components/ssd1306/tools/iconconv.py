@@ -0,0 +1,163 @@
+#!/usr/bin/env python3
+"""
+iconconv.py - gather bitmap arrays from C sources into an ssd1306_icon_t atlas
+
+Every const array in the sources becomes one atlas entry, stored in the
+panel's native layout: one row of width bytes per 8 pixel page, bit 0 at
+the top. Drawing a page aligned icon is then a memcpy per page, see
+_ssd1306_draw_icon().
+
+Source formats, told apart by the element type:
+  unsigned char / uint8_t   row-major, MSB first, rows padded to whole bytes.
+                            The size is taken from the name, e.g.
+                            home_icon16x16 or colon_bitmap_32x32.
+                            Missing trailing bytes are blank rows.
+  uint16_t                  one element per column, bit 0 at the top, 16 rows
+
+Entries are named after the array with the size suffix removed:
+home_icon16x16 becomes ICON_HOME.
+
+Usage:
+  iconconv.py NAME SOURCE.c [SOURCE.c ...] [--enum-prefix ICON_] [-o DIR]
+"""
+
+import argparse
+import os
+import re
+import sys
+
+ARRAY = re.compile(r'const\s+(unsigned\s+char|uint8_t|uint16_t)\s+(\w+)\s*\[[^\]]*\]\s*=\s*\{(.*?)\}\s*;', re.S)
+SIZE = re.compile(r'_?(?:icon|bitmap)?_?(\d+)x(\d+)$')
+
+
+class Icon:
+	def __init__(self, symbol, source, width, height, columns):
+		self.symbol = symbol
+		self.source = source
+		self.width = width
+		self.height = height
+		self.columns = columns		# list of ints, bit 0 is the top row
+
+
+def strip_comments(text):
+	text = re.sub(r'/\*.*?\*/', ' ', text, flags=re.S)
+	return re.sub(r'//[^\n]*', ' ', text)
+
+
+def parse_values(body):
+	values = []
+	for token in body.split(','):
+		token = token.strip()
+		if not token:
+			continue
+		if token.lower().startswith('0b'):
+			values.append(int(token[2:], 2))
+		else:
+			values.append(int(token, 0))
+	return values
+
+
+def load_icons(path):
+	with open(path) as f:
+		text = strip_comments(f.read())
+	icons = []
+	for ctype, symbol, body in ARRAY.findall(text):
+		values = parse_values(body)
+		if ctype == 'uint16_t':
+			icons.append(Icon(symbol, path, len(values), 16, values))
+			continue
+		m = SIZE.search(symbol)
+		if m is None:
+			sys.exit("%s: %s has no WxH size in its name" % (path, symbol))
+		width, height = int(m.group(1)), int(m.group(2))
+		stride = (width + 7) // 8
+		values = (values + [0] * (stride * height))[:stride * height]
+		columns = []
+		for x in range(width):
+			column = 0
+			for y in range(height):
+				if values[y * stride + x // 8] & (0x80 >> (x % 8)):
+					column |= 1 << y
+			columns.append(column)
+		icons.append(Icon(symbol, path, width, height, columns))
+	return icons
+
+
+def entry_name(symbol):
+	return SIZE.sub('', symbol).upper()
+
+
+def main():
+	parser = argparse.ArgumentParser(description="Convert C bitmap arrays to an ssd1306_icon_t atlas")
+	parser.add_argument('name', help="C identifier of the atlas, e.g. icon_atlas")
+	parser.add_argument('sources', nargs='+', help="C files holding the bitmaps")
+	parser.add_argument('--enum-prefix', default='ICON_', help="prefix of the entry names")
+	parser.add_argument('-o', '--output', default='.', help="directory for NAME.c and NAME.h")
+	args = parser.parse_args()
+
+	icons = []
+	names = {}
+	for source in args.sources:
+		for icon in load_icons(source):
+			name = args.enum_prefix + entry_name(icon.symbol)
+			if name in names:
+				sys.exit("%s: %s duplicates %s from %s" % (source, icon.symbol, names[name].symbol, names[name].source))
+			if icon.width > 0xFF or icon.height > 64:
+				sys.exit("%s: %s is %dx%d, larger than the panel" % (source, icon.symbol, icon.width, icon.height))
+			names[name] = icon
+			icon.name = name
+			icons.append(icon)
+
+	bitmap = bytearray()
+	offsets = []
+	for icon in icons:
+		offsets.append(len(bitmap))
+		for page in range((icon.height + 7) // 8):
+			bitmap += bytes((column >> (page * 8)) & 0xFF for column in icon.columns)
+	if len(bitmap) > 0xFFFF:
+		sys.exit("atlas of %d bytes is larger than expected" % len(bitmap))
+
+	guard = args.name.upper() + '_H_'
+	enum = args.name + '_id_t'
+	sources = ", ".join(os.path.basename(source) for source in args.sources)
+	with open(os.path.join(args.output, args.name + '.h'), 'w') as f:
+		f.write("/*\n")
+		f.write(" * %s.h\n" % args.name)
+		f.write(" *\n")
+		f.write(" * Generated by tools/iconconv.py from %s. Do not edit.\n" % sources)
+		f.write(" */\n\n")
+		f.write("#ifndef %s\n#define %s\n\n" % (guard, guard))
+		f.write('#include "ssd1306.h"\n\n')
+		f.write("typedef enum {\n")
+		for icon in icons:
+			f.write("\t%s,\t// %s, %dx%d\n" % (icon.name, icon.symbol, icon.width, icon.height))
+		f.write("\t%sCOUNT\n" % args.enum_prefix)
+		f.write("} %s;\n\n" % enum)
+		f.write("extern const ssd1306_icon_t %s[%sCOUNT];\n\n" % (args.name, args.enum_prefix))
+		f.write("#endif /* %s */\n" % guard)
+
+	with open(os.path.join(args.output, args.name + '.c'), 'w') as f:
+		f.write("/*\n")
+		f.write(" * %s.c\n" % args.name)
+		f.write(" *\n")
+		f.write(" * Generated by tools/iconconv.py from %s. Do not edit.\n" % sources)
+		f.write(" * %d icons, %d bytes in page/column layout.\n" % (len(icons), len(bitmap)))
+		f.write(" */\n\n")
+		f.write('#include "%s.h"\n\n' % args.name)
+		f.write("static const uint8_t %s_bitmap[] = {\n" % args.name)
+		for icon, offset in zip(icons, offsets):
+			f.write("\t// %s\n" % icon.name)
+			for page in range((icon.height + 7) // 8):
+				start = offset + page * icon.width
+				f.write("\t%s,\n" % ", ".join("0x%02X" % b for b in bitmap[start:start + icon.width]))
+		if not bitmap:
+			f.write("\t0x00\n")
+		f.write("};\n\n")
+		f.write("const ssd1306_icon_t %s[%sCOUNT] = {\n" % (args.name, args.enum_prefix))
+		for icon, offset in zip(icons, offsets):
+			f.write("\t[%s] = { %d, %d, &%s_bitmap[%d] },\n" % (icon.name, icon.width, icon.height, args.name, offset))
+		f.write("};\n")
+
+
+if __name__ == '__main__':
+	main()
@@ -0,0 +1,84 @@
+#!/usr/bin/env python3
+"""
+scaleconv.py - pre-scale font8x8_basic.h glyphs for ssd1306_display_text_scaled
+
+Each selected character is scaled 2x up to --max-scale times and stored in
+the panel's layout: a glyph at scale s is s pages of 8*s columns, page after
+page, so the renderer copies it with one memcpy per page. Characters outside
+the set are not stored; the renderer scales them on the fly.
+
+Usage:
+  scaleconv.py font8x8_basic.h [--chars " %+-./0123456789:ABC..."]
+               [--max-scale 4] [-o font8x8_scaled.c]
+"""
+
+import argparse
+import os
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from fontconv import load_font8x8, scale_columns
+
+# Everything the scaled UI text shows: numbers, times, percentages and short upper case words
+DEFAULT_CHARS = " %+-./0123456789:ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+
+
+def scale_glyph(columns, scale):
+	"""Return the glyph as scale pages of 8*scale bytes"""
+	wide = scale_columns(columns, 8, scale)
+	data = bytearray()
+	for page in range(scale):
+		data += bytes((column >> (page * 8)) & 0xFF for column in wide)
+	return data
+
+
+def main():
+	parser = argparse.ArgumentParser(description="Pre-scale font8x8_basic.h glyphs into a C source")
+	parser.add_argument('source', help="font8x8_basic.h")
+	parser.add_argument('--chars', default=DEFAULT_CHARS, help="ASCII characters to pre-scale")
+	parser.add_argument('--max-scale', type=int, default=4, help="largest scale, SSD1306_TEXT_SCALE_MAX")
+	parser.add_argument('-o', '--output', default='font8x8_scaled.c')
+	args = parser.parse_args()
+
+	_, cells = load_font8x8(args.source)
+	chars = sorted(set(ord(ch) for ch in args.chars))
+	for code in chars:
+		if code > 0x7F or code not in cells:
+			sys.exit("U+%04X is not in %s" % (code, args.source))
+	if len(chars) > 0x7F:
+		sys.exit("%d characters exceed the 8 bit index" % len(chars))
+
+	index = [-1] * 128
+	for n, code in enumerate(chars):
+		index[code] = n
+
+	scales = range(2, args.max_scale + 1)
+	total = sum(len(chars) * 8 * scale * scale for scale in scales)
+	with open(args.output, 'w') as f:
+		f.write("/*\n")
+		f.write(" * %s\n" % os.path.basename(args.output))
+		f.write(" *\n")
+		f.write(" * Generated by tools/scaleconv.py from %s. Do not edit.\n" % os.path.basename(args.source))
+		f.write(" * %d characters at scale 2 - %d, %d bytes of glyph data.\n" % (len(chars), args.max_scale, total))
+		f.write(" */\n\n")
+		f.write('#include <stddef.h>\n')
+		f.write('#include "ssd1306_font.h"\n\n')
+		f.write("const int8_t font8x8_scaled_index[128] = {\n")
+		for row in range(0, 128, 16):
+			f.write("\t%s,\t// U+%04X\n" % (", ".join("%2d" % v for v in index[row:row + 16]), row))
+		f.write("};\n\n")
+		for scale in scales:
+			f.write("static const uint8_t font8x8_x%d[] = {\n" % scale)
+			for code in chars:
+				data = scale_glyph(cells[code], scale)
+				f.write(("\t%s,\t// U+%04X %s" % (", ".join("0x%02X" % b for b in data), code, chr(code))).rstrip() + "\n")
+			f.write("};\n\n")
+		f.write("const uint8_t * const font8x8_scaled[%d] = {\n" % (args.max_scale + 1))
+		f.write("\tNULL, NULL,\n")
+		for scale in scales:
+			f.write("\tfont8x8_x%d,\n" % scale)
+		f.write("};\n")
+
+
+if __name__ == '__main__':
+	main()
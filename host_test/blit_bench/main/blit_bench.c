@@ -0,0 +1,181 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "freertos/FreeRTOS.h"
+#include "ssd1306.h"
+#include "ssd1306_emu.h"
+
+// Cost of drawing a bitmap into the buffer: _ssd1306_blit() against the bit-by-bit
+// _ssd1306_bitmaps() it replaced, and _ssd1306_blit_columns() against the _ssd1306_pixel()
+// loop of the old ssd1306_draw_bitmap_16x16(). Before timing, random blits are checked to
+// leave the buffer exactly as the old code did.
+//
+//	idf.py --preview set-target linux
+//	idf.py build
+//	./build/blit_bench.elf
+//
+// The old code also slept one tick per bitmap row, which is reported apart; it dwarfs the rest.
+
+#define BENCH_REPEAT  20000  // Blits timed per case
+#define CHECK_REPEAT  2000   // Random blits compared with the old code
+
+// _ssd1306_bitmaps() and ssd1306_copy_bit() as they were, without the vTaskDelay(1) per row
+static uint8_t old_copy_bit(uint8_t src, int srcBits, uint8_t dst, int dstBits) {
+    uint8_t smask = 0x01 << srcBits;
+    uint8_t dmask = 0x01 << dstBits;
+    if (src & smask) {
+        return dst | dmask;
+    }
+    return dst & ~dmask;
+}
+
+static void old_bitmaps(SSD1306_t *dev, int xpos, int ypos, const uint8_t *bitmap, int width, int height, bool invert) {
+    int _width = width / 8;
+    uint8_t page = ypos / 8;
+    uint8_t _seg = xpos;
+    uint8_t dstBits = ypos % 8;
+    int offset = 0;
+    for (int _height = 0; _height < height; _height++) {
+        for (int index = 0; index < _width; index++) {
+            for (int srcBits = 7; srcBits >= 0; srcBits--) {
+                uint8_t wk0 = dev->_page[page]._segs[_seg];
+                if (dev->_flip) wk0 = ssd1306_rotate_byte(wk0);
+                uint8_t wk1 = bitmap[index + offset];
+                if (invert) wk1 = ~wk1;
+                uint8_t wk2 = old_copy_bit(wk1, srcBits, wk0, dstBits);
+                if (dev->_flip) wk2 = ssd1306_rotate_byte(wk2);
+                dev->_page[page]._segs[_seg] = wk2;
+                _seg++;
+            }
+        }
+        offset = offset + _width;
+        dstBits++;
+        _seg = xpos;
+        if (dstBits == 8) {
+            page++;
+            dstBits = 0;
+        }
+    }
+}
+
+// The old ssd1306_draw_bitmap_16x16(), without its flush: one _ssd1306_pixel() per pixel
+static void old_bitmap_16x16(SSD1306_t *dev, int x, int y, const uint16_t *bitmap) {
+    for (int col = 0; col < 16; col++) {
+        for (int bit = 0; bit < 16; bit++) {
+            bool is_on = (bitmap[col] >> bit) & 0x01;
+            _ssd1306_pixel(dev, x + col, y + bit, !is_on);
+        }
+    }
+}
+
+static int64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void random_fill(uint8_t *buf, int len) {
+    for (int i = 0; i < len; i++) {
+        buf[i] = rand();
+    }
+}
+
+// Random in-bounds COPY blits, widths a multiple of 8 as the old code required
+static int check_blit(SSD1306_t *dev) {
+    static uint8_t before[SSD1306_FB_LEN];
+    static uint8_t expected[SSD1306_FB_LEN];
+    uint8_t bitmap[64 / 8 * 64];
+    int failed = 0;
+
+    for (int i = 0; i < CHECK_REPEAT; i++) {
+        int width = 8 * (1 + rand() % 8);
+        int height = 1 + rand() % 64;
+        int xpos = rand() % (dev->_width - width + 1);
+        int ypos = rand() % (dev->_height - height + 1);
+        bool invert = rand() & 1;
+        random_fill(bitmap, width / 8 * height);
+        random_fill(before, SSD1306_FB_LEN);
+
+        memcpy(dev->_fb, before, SSD1306_FB_LEN);
+        old_bitmaps(dev, xpos, ypos, bitmap, width, height, invert);
+        memcpy(expected, dev->_fb, SSD1306_FB_LEN);
+
+        memcpy(dev->_fb, before, SSD1306_FB_LEN);
+        _ssd1306_blit(dev, xpos, ypos, bitmap, width, height, BLIT_COPY, invert);
+        if (memcmp(expected, dev->_fb, SSD1306_FB_LEN) != 0) {
+            printf("blit %dx%d at %d,%d%s differs from the old code\n", width, height, xpos, ypos, invert ? " inverted" : "");
+            failed++;
+        }
+    }
+    return failed;
+}
+
+static void bench_bitmap(SSD1306_t *dev, int width, int height, int ypos) {
+    uint8_t bitmap[64 / 8 * 64];
+    random_fill(bitmap, width / 8 * height);
+    int xpos = 16;
+
+    int64_t start = now_ns();
+    for (int i = 0; i < BENCH_REPEAT; i++) {
+        old_bitmaps(dev, xpos, ypos, bitmap, width, height, false);
+    }
+    int64_t old_ns = (now_ns() - start) / BENCH_REPEAT;
+
+    start = now_ns();
+    for (int i = 0; i < BENCH_REPEAT; i++) {
+        _ssd1306_blit(dev, xpos, ypos, bitmap, width, height, BLIT_COPY, false);
+    }
+    int64_t new_ns = (now_ns() - start) / BENCH_REPEAT;
+
+    printf("%2dx%-2d at y=%-2d  %6lld ns  %6lld ns  %5.1fx  + %d ticks of vTaskDelay before\n",
+           width, height, ypos, (long long)old_ns, (long long)new_ns,
+           new_ns ? (double)old_ns / new_ns : 0.0, height);
+}
+
+static void bench_icon(SSD1306_t *dev, int ypos) {
+    uint16_t icon[16];
+    uint8_t columns[2 * 16];  // Two pages of 16 columns, the panel layout of the same icon
+    for (int col = 0; col < 16; col++) {
+        icon[col] = rand();
+        columns[col] = icon[col] & 0xFF;
+        columns[16 + col] = icon[col] >> 8;
+    }
+
+    int64_t start = now_ns();
+    for (int i = 0; i < BENCH_REPEAT; i++) {
+        old_bitmap_16x16(dev, 40, ypos, icon);
+    }
+    int64_t old_ns = (now_ns() - start) / BENCH_REPEAT;
+
+    start = now_ns();
+    for (int i = 0; i < BENCH_REPEAT; i++) {
+        _ssd1306_blit_columns(dev, 40, ypos, columns, 16, 16, BLIT_COPY, false);
+    }
+    int64_t new_ns = (now_ns() - start) / BENCH_REPEAT;
+
+    printf("16x16 icon y=%-2d %6lld ns  %6lld ns  %5.1fx\n",
+           ypos, (long long)old_ns, (long long)new_ns, new_ns ? (double)old_ns / new_ns : 0.0);
+}
+
+void app_main(void) {
+    static SSD1306_t dev;
+
+    ssd1306_emu_init(&dev);
+    ssd1306_init(&dev, 128, 64);
+
+    int failed = check_blit(&dev);
+    printf("%d random blits compared with the old code, %d differ\n\n", CHECK_REPEAT, failed);
+
+    printf("bitmap           old        new        speed-up\n");
+    bench_bitmap(&dev, 8, 8, 0);
+    bench_bitmap(&dev, 16, 16, 0);
+    bench_bitmap(&dev, 16, 16, 3);
+    bench_bitmap(&dev, 32, 32, 0);
+    bench_bitmap(&dev, 32, 32, 5);
+    bench_bitmap(&dev, 64, 32, 8);
+    bench_icon(&dev, 16);
+    bench_icon(&dev, 19);
+
+    exit(failed ? 1 : 0);
+}
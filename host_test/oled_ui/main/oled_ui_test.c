@@ -0,0 +1,185 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "esp_log.h"
+#include "ssd1306.h"
+#include "ssd1306_emu.h"
+#include "oled_ui.h"
+
+// Golden-image test of the contextual screens.
+// Every screen is rendered by the application code through the panel emulator, and what the
+// emulated panel shows is compared with golden/<name>.pgm. The bytes each screen put on the
+// bus are printed as well.
+//
+//	idf.py --preview set-target linux
+//	idf.py build
+//	./build/oled_ui_test.elf                     compare, exits with 1 on a difference
+//	OLED_UI_UPDATE=1 ./build/oled_ui_test.elf    rewrite the golden images after an intended change
+//
+// A failing screen is saved as <name>.actual.png in the working directory.
+// Afterwards every screen is entered again with a slide and rendered for a while, which must
+// not allocate: the display path allocates in ssd1306_init and on the first entry of a screen.
+
+static const char *TAG = "OLED_UI_TEST";
+
+#define FIXED_TIME 1700000000  // Tue 14/11/2023 22:13:20 UTC
+
+typedef struct {
+    const char *name;
+    void (*show)(SSD1306_t *dev);
+} ui_test_case_t;
+
+static time_t fixed_time(time_t *now) {
+    *now = FIXED_TIME;
+    return FIXED_TIME;
+}
+
+static void show_main(SSD1306_t *dev) {
+    ui_show_main(dev);
+}
+
+static void show_desk(SSD1306_t *dev) {
+    ui_show_desk(dev, 72.5, false, false);
+}
+
+static void show_desk_moving(SSD1306_t *dev) {
+    ui_show_desk(dev, 68.0, true, true);
+}
+
+static void show_volume(SSD1306_t *dev) {
+    ui_show_volume(dev, 40);
+}
+
+static void show_volume_full(SSD1306_t *dev) {
+    ui_show_volume(dev, 100);
+}
+
+// Scene names as sent by the rotary encoder, UTF-8 with æ, ø and å
+static void show_hue(SSD1306_t *dev) {
+    ui_show_hue(dev, "Få ny energi", 75);
+}
+
+static void show_hue_danish(SSD1306_t *dev) {
+    ui_show_hue(dev, "Læs på sølvbænken", 20);
+}
+
+static void show_pc_switch(SSD1306_t *dev) {
+    ui_show_pc_switch(dev, 2);
+}
+
+static void show_window(SSD1306_t *dev) {
+    ui_show_window(dev, true, false, false);
+}
+
+static void show_window_ack(SSD1306_t *dev) {
+    ui_show_window(dev, false, true, true);
+}
+
+static void show_fan(SSD1306_t *dev) {
+    ui_show_fan(dev, 60, true);
+}
+
+static void show_fan_stopped(SSD1306_t *dev) {
+    ui_show_fan(dev, 0, false);
+}
+
+// In this order every screen is entered from another one, so the templates and the
+// partial redraws are checked as well as the first render
+static const ui_test_case_t ui_test_cases[] = {
+    { "main", show_main },
+    { "desk", show_desk },
+    { "desk_moving", show_desk_moving },
+    { "volume", show_volume },
+    { "volume_full", show_volume_full },
+    { "hue", show_hue },
+    { "hue_danish", show_hue_danish },
+    { "pc_switch", show_pc_switch },
+    { "window", show_window },
+    { "window_ack", show_window_ack },
+    { "fan", show_fan },
+    { "fan_stopped", show_fan_stopped },
+    { "volume_again", show_volume },
+    { "main_again", show_main },
+};
+
+#define ALLOC_CHECK_FRAMES 16  // Renders of each screen, enough to scroll the hue scene
+
+// Enter every screen again and render it repeatedly. Returns the heap allocations made.
+static uint32_t frame_allocs(SSD1306_t *dev) {
+    uint32_t allocs = ssd1306_get_allocs(dev);
+    for (int i = 0; i < sizeof(ui_test_cases) / sizeof(ui_test_cases[0]); i++) {
+        ssd1306_anim_begin(dev);
+        ui_test_cases[i].show(dev);
+        ssd1306_anim_start(dev, ANIM_SLIDE_LEFT, 100);
+        ssd1306_anim_finish(dev);
+        for (int frame = 0; frame < ALLOC_CHECK_FRAMES; frame++) {
+            ui_render(dev, ui_shown_state());
+        }
+    }
+    return ssd1306_get_allocs(dev) - allocs;
+}
+
+void app_main(void) {
+    static SSD1306_t dev;
+    bool update = getenv("OLED_UI_UPDATE") != NULL;
+    int failed = 0;
+
+    setenv("TZ", "UTC0", 1);
+    tzset();
+    ui_set_time_source(fixed_time);
+
+    ssd1306_emu_init(&dev);
+    ssd1306_init(&dev, SCREEN_WIDTH, SCREEN_HEIGHT);
+
+    for (int i = 0; i < sizeof(ui_test_cases) / sizeof(ui_test_cases[0]); i++) {
+        const ui_test_case_t *test = &ui_test_cases[i];
+        char path[256];
+        ssd1306_emu_stats_t stats;
+
+        ssd1306_emu_reset_stats();
+        test->show(&dev);
+        ssd1306_emu_get_stats(&stats);
+
+        // The _again cases must match the image of their first render
+        const char *golden = test->name;
+        char base[32];
+        const char *again = strstr(test->name, "_again");
+        if (again != NULL) {
+            snprintf(base, sizeof(base), "%.*s", (int)(again - test->name), test->name);
+            golden = base;
+        }
+        snprintf(path, sizeof(path), "%s/%s.pgm", GOLDEN_DIR, golden);
+
+        if (update && again == NULL) {
+            if (!ssd1306_emu_save_pgm(path, 1)) {
+                failed++;
+            }
+            printf("%-14s written, %4lu bytes on the bus\n", test->name, (unsigned long)stats.bytes);
+            continue;
+        }
+        int diff = ssd1306_emu_diff_pgm(path);
+        if (diff == 0) {
+            printf("%-14s ok,      %4lu bytes on the bus\n", test->name, (unsigned long)stats.bytes);
+            continue;
+        }
+        failed++;
+        snprintf(path, sizeof(path), "%s.actual.png", test->name);
+        ssd1306_emu_save_png(path, 4);
+        if (diff < 0) {
+            ESP_LOGE(TAG, "%s: no golden image %s.pgm, see %s", test->name, golden, path);
+        } else {
+            ESP_LOGE(TAG, "%s: %d pixels differ from %s.pgm, see %s", test->name, diff, golden, path);
+        }
+    }
+
+    printf("%d of %d screens failed\n", failed, (int)(sizeof(ui_test_cases) / sizeof(ui_test_cases[0])));
+
+    uint32_t allocs = frame_allocs(&dev);
+    printf("%lu heap allocations while rendering the screens again\n", (unsigned long)allocs);
+    if (allocs != 0) {
+        ESP_LOGE(TAG, "the display path allocated after the first entry of every screen");
+        failed++;
+    }
+    exit(failed ? 1 : 0);
+}
@@ -11,7 +11,7 @@
 #include "hid_device/hid_device.h"
 void app_main(void)
 {
-    SSD1306_t dev;
+    static SSD1306_t dev;  // Outlives app_main: the display flush task keeps a pointer to it
 
     // Initialize OLED display (3.3V rail fixed!)
     ESP_LOGI("MAIN", "Initializing OLED display...");
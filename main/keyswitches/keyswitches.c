@@ -15,7 +15,12 @@ static const char *KEYTAG = "KEYSWITCHES";
 bool lights_on = false;
 int brightness_value = 255;  // Start at max brightness
 int brightness_step = 25;
-int current_scene = 1;  // Track current Hue scene (1-4)
+int current_scene = 1;  // Track current Hue scene (1-HUE_SCENE_COUNT)
+// Scene names as shown in the Hue app, indexed by current_scene - 1 (UTF-8)
+static const char *hue_scene_names[] = {
+    "Få ny energi", "Koncentrer dig", "Læs", "Slap af", "Slap af v2", "Studyin'", "Natlys"
+};
+#define HUE_SCENE_COUNT ((int)(sizeof(hue_scene_names) / sizeof(hue_scene_names[0])))
 
 #define DEBOUNCE_DELAY_MS 150  // Debounce delay of 150 ms
 #define TAP_THRESHOLD_MS 500
@@ -260,7 +265,7 @@ void poll_rotary_encoders(SSD1306_t *dev) {
             if (rot2_dt == 0) {  // SWAPPED: DT=0 means clockwise
                 // Clockwise - next scene
                 current_scene++;
-                if (current_scene > 7) {
+                if (current_scene > HUE_SCENE_COUNT) {
                     current_scene = 1;
                 }
                 ESP_LOGI(KEYTAG, "Rotary Encoder 2 turned Clockwise - Next scene");
@@ -268,7 +273,7 @@ void poll_rotary_encoders(SSD1306_t *dev) {
                 // Counterclockwise - previous scene
                 current_scene--;
                 if (current_scene < 1) {
-                    current_scene = 7;
+                    current_scene = HUE_SCENE_COUNT;
                 }
                 ESP_LOGI(KEYTAG, "Rotary Encoder 2 turned Counterclockwise - Previous scene");
             }
@@ -314,6 +319,8 @@ void poll_rotary_encoders(SSD1306_t *dev) {
             }
 
             hue_send_command("http://192.168.50.170/api/AicZqASmH6YLHxDyBxD-pci3vEmn0jLU0XvQ9g9N/groups/1/action", scene_command);
+            ui_set_hue_context(hue_scene_names[current_scene - 1], brightness_value * 100 / 255);
+            ui_set_state(UI_STATE_HUE, 3000);
         }
     }
     previous_rot2_clk = rot2_clk;
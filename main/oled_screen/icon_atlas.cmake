@@ -0,0 +1,20 @@
+# Icon atlas in the panel's page/column layout, generated from the icon sources.
+# Included after idf_component_register() by every component that draws the screens,
+# so the application and the host tests build the same atlas.
+idf_build_get_property(python PYTHON)
+idf_component_get_property(ssd1306_dir ssd1306 COMPONENT_DIR)
+idf_component_get_property(iconset_dir iot_iconset COMPONENT_DIR)
+set(icon_sources
+    "${iconset_dir}/iot_iconset_16x16.c"
+    "${CMAKE_CURRENT_LIST_DIR}/bitmap_numbers/bitmap_numbers.c"
+    "${CMAKE_CURRENT_LIST_DIR}/status_icons/status_icons.c")
+set(icon_atlas "${CMAKE_CURRENT_BINARY_DIR}/icon_atlas.c" "${CMAKE_CURRENT_BINARY_DIR}/icon_atlas.h")
+add_custom_command(OUTPUT ${icon_atlas}
+    COMMAND ${python} "${ssd1306_dir}/tools/iconconv.py" icon_atlas ${icon_sources} -o "${CMAKE_CURRENT_BINARY_DIR}"
+    DEPENDS ${icon_sources} "${ssd1306_dir}/tools/iconconv.py"
+    VERBATIM)
+add_custom_target(icon_atlas DEPENDS ${icon_atlas})
+add_dependencies(${COMPONENT_LIB} icon_atlas)
+target_sources(${COMPONENT_LIB} PRIVATE "${CMAKE_CURRENT_BINARY_DIR}/icon_atlas.c")
+target_include_directories(${COMPONENT_LIB} PRIVATE "${CMAKE_CURRENT_BINARY_DIR}")
+set_property(DIRECTORY "${CMAKE_CURRENT_SOURCE_DIR}" APPEND PROPERTY ADDITIONAL_CLEAN_FILES ${icon_atlas})
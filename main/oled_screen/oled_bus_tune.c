@@ -0,0 +1,207 @@
+#include "oled_bus_tune.h"
+#include "freertos/FreeRTOS.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "nvs_flash.h"
+#include "nvs.h"
+#include <string.h>
+
+// I2C clock benchmark of the OLED bus.
+// The panel is write-only over I2C, so a transfer counts as good when every byte was
+// acknowledged; the driver reports a NACK or a timeout as a failed transaction and the
+// ssd1306 bus counters collect them.
+
+static const char *TAG = "OLED_TUNE";
+
+#define TUNE_NVS_NAMESPACE "oled"
+#define TUNE_NVS_KEY       "i2c_hz"
+
+// nvs_flash_init() is also called by wifi_init_sta(); a second call is harmless.
+// A partition that needs erasing is left to it, the tuned speed is then simply missing.
+static bool tune_nvs_ready(void) {
+    esp_err_t ret = nvs_flash_init();
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "NVS not available: %s", esp_err_to_name(ret));
+        return false;
+    }
+    return true;
+}
+
+// Tuned SCL frequency stored by an earlier oled_bus_tune_run(), 0 when there is none
+uint32_t oled_bus_tune_load(void) {
+    if (!tune_nvs_ready()) {
+        return 0;
+    }
+    nvs_handle_t handle;
+    if (nvs_open(TUNE_NVS_NAMESPACE, NVS_READONLY, &handle) != ESP_OK) {
+        return 0;
+    }
+    uint32_t clk_hz = 0;
+    if (nvs_get_u32(handle, TUNE_NVS_KEY, &clk_hz) != ESP_OK) {
+        clk_hz = 0;
+    }
+    nvs_close(handle);
+    return clk_hz;
+}
+
+static void tune_save(uint32_t clk_hz) {
+    if (!tune_nvs_ready()) {
+        return;
+    }
+    nvs_handle_t handle;
+    esp_err_t ret = nvs_open(TUNE_NVS_NAMESPACE, NVS_READWRITE, &handle);
+    if (ret == ESP_OK) {
+        ret = nvs_set_u32(handle, TUNE_NVS_KEY, clk_hz);
+        if (ret == ESP_OK) {
+            ret = nvs_commit(handle);
+        }
+        nvs_close(handle);
+    }
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Could not store the I2C speed: %s", esp_err_to_name(ret));
+    }
+}
+
+static void tune_forget(void) {
+    if (!tune_nvs_ready()) {
+        return;
+    }
+    nvs_handle_t handle;
+    if (nvs_open(TUNE_NVS_NAMESPACE, NVS_READWRITE, &handle) == ESP_OK) {
+        if (nvs_erase_key(handle, TUNE_NVS_KEY) == ESP_OK) {
+            nvs_commit(handle);
+        }
+        nvs_close(handle);
+    }
+}
+
+
+// Test frames with many bit transitions on SDA: checkerboards, solid and a ramp
+static void tune_fill_frame(SSD1306_t *dev, int frame) {
+    static uint32_t words[SSD1306_FB_LEN / 4];  // Word aligned for ssd1306_set_buffer
+    uint8_t *image = (uint8_t *)words;
+    switch (frame % 4) {
+    case 0:
+    case 1: {
+        uint8_t even = (frame % 4) ? 0x55 : 0xAA;
+        for (int i = 0; i < SSD1306_FB_LEN; i++) {
+            image[i] = (i & 1) ? (uint8_t)~even : even;
+        }
+        break;
+    }
+    case 2:
+        memset(image, 0xFF, SSD1306_FB_LEN);
+        break;
+    default:
+        for (int i = 0; i < SSD1306_FB_LEN; i++) {
+            image[i] = (uint8_t)i;
+        }
+        break;
+    }
+    ssd1306_set_buffer(dev, image);
+}
+
+// Leave the panel blank after the test frames
+static void tune_clear(SSD1306_t *dev) {
+    _ssd1306_clear_screen(dev, false);
+    ssd1306_show_frame(dev);
+}
+
+// Push OLED_BUS_TUNE_FRAMES full frames at the current speed. Stops at the first error.
+static void tune_measure(SSD1306_t *dev, uint32_t clk_hz, oled_bus_tune_result_t *result) {
+    ssd1306_bus_stats_t before;
+    ssd1306_bus_stats_t after;
+    memset(result, 0, sizeof(*result));
+    result->clk_hz = clk_hz;
+
+    ssd1306_get_bus_stats(dev, &before);
+    int64_t start = esp_timer_get_time();
+    for (int frame = 0; frame < OLED_BUS_TUNE_FRAMES; frame++) {
+        tune_fill_frame(dev, frame);
+        ssd1306_show_frame(dev);
+        result->frames++;
+        ssd1306_get_bus_stats(dev, &after);
+        if (after.errors != before.errors) {
+            break;
+        }
+    }
+    int64_t elapsed = esp_timer_get_time() - start;
+
+    result->transactions = after.transactions - before.transactions;
+    result->errors = after.errors - before.errors;
+    if (elapsed > 0) {
+        result->bytes_per_s = (uint32_t)((uint64_t)(after.payload_bytes - before.payload_bytes) * 1000000 / elapsed);
+    }
+}
+
+// Sweep OLED_BUS_TUNE_SPEEDS from the slowest up, pushing test frames at each one, and
+// keep the fastest speed that went through without a single error. The sweep stops at the
+// first speed with errors. The result is applied, stored in NVS and returned; 0 when even
+// the slowest speed failed, in which case the bus is left at the slowest speed.
+// Run it after ssd1306_init() and before ssd1306_start_flush_task(): the frames are timed
+// as they are sent, so the flush task must not own the bus. The screen is left blank.
+uint32_t oled_bus_tune_run(SSD1306_t *dev, i2c_manager_device_t device) {
+    static const uint32_t speeds[] = OLED_BUS_TUNE_SPEEDS;
+    uint32_t best = 0;
+
+    if (dev->_flushTask != NULL) {
+        ESP_LOGE(TAG, "The benchmark cannot run with the flush task started");
+        return 0;
+    }
+
+    ESP_LOGI(TAG, "Benchmarking the OLED I2C clock");
+    for (int i = 0; i < sizeof(speeds) / sizeof(speeds[0]); i++) {
+        oled_bus_tune_result_t result;
+        i2c_manager_set_clock(device, speeds[i]);
+        tune_measure(dev, speeds[i], &result);
+        ESP_LOGI(TAG, "%4lu kHz: %lu frames, %lu transactions, %lu errors, %lu bytes/s",
+                 (unsigned long)(result.clk_hz / 1000), (unsigned long)result.frames,
+                 (unsigned long)result.transactions, (unsigned long)result.errors,
+                 (unsigned long)result.bytes_per_s);
+        if (result.errors != 0) {
+            break;
+        }
+        best = speeds[i];
+    }
+
+    // A failed transfer may have cut a command short, so bring the panel back to a known state
+    i2c_manager_set_clock(device, best ? best : speeds[0]);
+    ssd1306_reinit(dev);
+    tune_clear(dev);
+
+    if (best == 0) {
+        ESP_LOGE(TAG, "No reliable I2C speed found");
+        return 0;
+    }
+    ESP_LOGI(TAG, "Using %lu kHz", (unsigned long)(best / 1000));
+    tune_save(best);
+    return best;
+}
+
+// Check a speed loaded by oled_bus_tune_load() with one test frame before trusting it.
+// When the frame is not acknowledged, e.g. after a wiring change, the bus falls back to
+// OLED_BUS_TUNE_FALLBACK_HZ and the stored speed is erased, so the next boot benchmarks again.
+// Returns the speed in use. Same conditions as oled_bus_tune_run(); the screen is left blank.
+uint32_t oled_bus_tune_verify(SSD1306_t *dev, i2c_manager_device_t device, uint32_t clk_hz) {
+    ssd1306_bus_stats_t before;
+    ssd1306_bus_stats_t after;
+
+    if (dev->_flushTask != NULL) {
+        ESP_LOGE(TAG, "The check cannot run with the flush task started");
+        return clk_hz;
+    }
+    ssd1306_get_bus_stats(dev, &before);
+    tune_fill_frame(dev, 0);
+    ssd1306_show_frame(dev);
+    ssd1306_get_bus_stats(dev, &after);
+    if (after.errors != before.errors) {
+        ESP_LOGW(TAG, "Stored speed of %lu kHz failed, using %lu kHz",
+                 (unsigned long)(clk_hz / 1000), (unsigned long)(OLED_BUS_TUNE_FALLBACK_HZ / 1000));
+        clk_hz = OLED_BUS_TUNE_FALLBACK_HZ;
+        i2c_manager_set_clock(device, clk_hz);
+        ssd1306_reinit(dev);
+        tune_forget();
+    }
+    tune_clear(dev);
+    return clk_hz;
+}
@@ -0,0 +1,26 @@
+#ifndef OLED_BUS_TUNE_H
+#define OLED_BUS_TUNE_H
+
+#include <stdint.h>
+#include "ssd1306.h"
+#include "i2c_manager.h"
+
+// SCL frequencies tried by oled_bus_tune_run(), slowest first
+#define OLED_BUS_TUNE_SPEEDS       { 100000, 400000, 600000, 800000, 1000000 }
+#define OLED_BUS_TUNE_FRAMES       16     // Full test frames pushed at each speed
+#define OLED_BUS_TUNE_FALLBACK_HZ  400000 // Used when the stored speed fails its check at boot
+
+// Result of one step of the sweep
+typedef struct {
+    uint32_t clk_hz;        // SCL frequency
+    uint32_t frames;        // Test frames pushed
+    uint32_t transactions;  // Bus transactions, each one ACK checked by the driver
+    uint32_t errors;        // Transactions that were not acknowledged or timed out
+    uint32_t bytes_per_s;   // Frame data throughput
+} oled_bus_tune_result_t;
+
+uint32_t oled_bus_tune_load(void);
+uint32_t oled_bus_tune_run(SSD1306_t *dev, i2c_manager_device_t device);
+uint32_t oled_bus_tune_verify(SSD1306_t *dev, i2c_manager_device_t device, uint32_t clk_hz);
+
+#endif // OLED_BUS_TUNE_H
@@ -2,61 +2,72 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/timers.h"
-#include "freertos/queue.h"
 #include "esp_log.h"
 #include "driver/i2c.h"
+#include "i2c_manager.h"
 #include "oled_screen.h"
 #include <string.h>
 #include "time.h"
 #include "wifi_connection/wifi_connection.h"
+#include "icon_atlas.h"
+#include "oled_bus_tune.h"
+#include "oled_widgets.h"
 
 // Log tag
 static const char *TAG = "OLED";
-const uint16_t bluetooth[] = {0x0000, 0x0300, 0x0380, 0x02c0, 0x1260, 0x1a60, 0x0ec0, 0x0780, 0x0300, 0x0780, 0x0ec0, 0x1a60, 0x1260, 0x02c0, 0x0380, 0x0300};
 // Define constants for screen layout and buffer
 #define ZONE_4_START_PAGE 2    // Pages 2-5 for the middle section (events and clock)
 #define ZONE_4_END_PAGE 5      
-#define DISPLAY_QUEUE_LENGTH 10
 #define CHAR_WIDTH_3X 24       // Each character is 24 pixels wide when scaled 3x
 #define SCREEN_WIDTH 128       // OLED screen width
 
-// Define the queue for display events
-QueueHandle_t display_queue;
+// Latest-value mailboxes, one per event type. A producer overwrites the mailbox of its type
+// and wakes the display task, so it never waits for the display; the display task draws
+// only the newest event of each type.
+typedef struct {
+    display_event_t event;
+    uint32_t seq;  // Posting order across all mailboxes
+} display_mailbox_t;
+
+static display_mailbox_t display_mailbox[DISPLAY_EVENT_COUNT];
+static uint32_t display_mailbox_full;  // Bit per mailbox holding an event not taken yet
+static uint32_t display_mailbox_seq;
+static portMUX_TYPE display_mailbox_lock = portMUX_INITIALIZER_UNLOCKED;
+static TaskHandle_t display_task_handle;
+
+// Frame-rate governor: minimum ticks between two rendered frames, and its counters
+static TickType_t frame_ticks = pdMS_TO_TICKS(1000 / DISPLAY_MAX_FPS);
+static display_stats_t display_stats;
+static portMUX_TYPE display_stats_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// Bus usage accounting: driver totals at the last sample, charged to the UI state shown
+static SSD1306_t *display_dev;
+static ssd1306_bus_stats_t bus_sampled;
+static TickType_t stats_logged;
+static const char *ui_state_names[UI_STATE_COUNT] = {
+    "main", "desk", "volume", "hue", "pc_switch", "window", "fan"
+};
 
 // Timer for event-driven display and reverting to the clock
 TimerHandle_t event_timer;
 bool is_showing_event = false;  // To track if an event is being displayed
 
-// Global UI context for new contextual display system
-static ui_context_t ui_ctx = {
-    .current_state = UI_STATE_MAIN,
-    .state_start_time = 0,
-    .display_duration_ms = 3000,  // 3 seconds default
-    .context = {
-        .desk_height = 0.0,
-        .desk_moving = false,
-        .desk_moving_up = false,
-        .volume_level = 50,
-        .hue_scene = "Unknown",
-        .hue_brightness = 50,
-        .pc_number = 1,
-        .window_opening = false,
-        .window_closing = false,
-        .http_ack_received = false,
-        .wifi_status = "●●●○",
-        .ip_address = "192.168.x.x",
-        .fan_speed_percent = 0,
-        .fan_active = false
-    }
-};
+// Panel on the shared I2C bus
+static i2c_manager_device_t oled_i2c;
+
+static esp_err_t oled_i2c_write(void *ctx, const uint8_t *buf, size_t len) {
+    return i2c_manager_write((i2c_manager_device_t)ctx, buf, len);
+}
 
 // Function declarations
 static void display_task(void *pvParameter);
+static void draw_time_x3(SSD1306_t *dev, const char *time);
 void oled_init(SSD1306_t *dev);
 void revert_to_clock(TimerHandle_t xTimer);  // Timer callback for reverting to clock
 
-// Initialize OLED and create display task and queue
+// Initialize OLED and create display task
 void oled_init(SSD1306_t *dev) {
+    display_dev = dev;
     dev->_address = OLED_I2C_ADDRESS;
     dev->_width = 128;
     dev->_height = 64;
@@ -64,15 +75,25 @@ void oled_init(SSD1306_t *dev) {
     dev->_i2c_num = I2C_NUM_0;
 
     // Initialize I2C and OLED
-    i2c_master_init_custom(dev, I2C_MASTER_SDA_IO, I2C_MASTER_SCL_IO, RESET_PIN);
+    uint32_t i2c_hz = oled_bus_tune_load();
+    i2c_master_init_custom(dev, I2C_MASTER_SDA_IO, I2C_MASTER_SCL_IO, RESET_PIN, i2c_hz ? i2c_hz : I2C_MASTER_FREQ_HZ);
     ssd1306_init(dev, dev->_width, dev->_height);
+    if (i2c_hz != 0) {
+        oled_bus_tune_verify(dev, oled_i2c, i2c_hz);
+    }
+#if OLED_I2C_AUTOTUNE
+    if (i2c_hz == 0) {
+        // First boot: find and store the fastest clock the wiring sustains
+        oled_bus_tune_run(dev, oled_i2c);
+    }
+#endif
+    // Transfers run on their own task so the UI only copies into the front buffer
+    ssd1306_start_flush_task(dev, 4);
     ESP_LOGI(TAG, "OLED initialized successfully");
 
-    // Create the display queue
-    display_queue = xQueueCreate(DISPLAY_QUEUE_LENGTH, sizeof(display_event_t));
-
-    // Create the display task
-    xTaskCreate(display_task, "display_task", 4096, (void *)dev, 5, NULL);
+    // Create the display task, woken by oled_send_display_event()
+    xTaskCreate(display_task, "display_task", 4096, (void *)dev, 5, &display_task_handle);
+    ui_set_render_task(display_task_handle);
 
     // Create the event timer to revert to the clock after 5-8 seconds
     event_timer = xTimerCreate("EventTimer", pdMS_TO_TICKS(5000), pdFALSE, (void *)0, revert_to_clock);
@@ -82,12 +103,13 @@ void oled_init(SSD1306_t *dev) {
 void display_event_message(SSD1306_t *dev, const char *message, int display_time_ms) {
     // Clear the middle part of the screen (Pages 2-5)
     for (int i = ZONE_4_START_PAGE; i <= ZONE_4_END_PAGE; i++) {
-        ssd1306_clear_line(dev, i, false);
+        _ssd1306_clear_line(dev, i, false);
     }
 
     // Display the event message centered on Pages 2-5
-    ssd1306_display_text(dev, ZONE_4_START_PAGE, (char *)message, strlen(message), false);
+    _ssd1306_display_text(dev, ZONE_4_START_PAGE, (char *)message, strlen(message), false);
     ssd1306_show_buffer(dev);
+    ui_invalidate();  // Drawn over the contextual UI
 
     // Set flag to indicate an event is being displayed
     is_showing_event = true;
@@ -109,72 +131,288 @@ void revert_to_clock(TimerHandle_t xTimer) {
     oled_send_display_event(&event);  // Revert to clock display
 }
 
-// Send an event to the display queue
+// Post an event to the mailbox of its type without blocking the caller.
+// An event of the same type that was not drawn yet is overwritten, so the newest state
+// always gets through and a burst of one type never crowds out the others.
 bool oled_send_display_event(display_event_t *event) {
-    if (display_queue != NULL) {
-        return xQueueSend(display_queue, event, portMAX_DELAY) == pdTRUE;
+    if (display_task_handle == NULL || event->event_type >= DISPLAY_EVENT_COUNT) {
+        return false;
+    }
+    uint32_t bit = 1u << event->event_type;
+
+    portENTER_CRITICAL(&display_mailbox_lock);
+    bool overwritten = (display_mailbox_full & bit) != 0;
+    display_mailbox[event->event_type].event = *event;
+    display_mailbox[event->event_type].seq = ++display_mailbox_seq;
+    display_mailbox_full |= bit;
+    portEXIT_CRITICAL(&display_mailbox_lock);
+
+    if (overwritten) {
+        portENTER_CRITICAL(&display_stats_lock);
+        display_stats.dropped++;
+        portEXIT_CRITICAL(&display_stats_lock);
+    }
+    xTaskNotifyGive(display_task_handle);
+    return true;
+}
+
+// Move every filled mailbox into mail and empty it. Returns the mask of the mailboxes taken.
+static uint32_t display_take_mail(display_mailbox_t *mail) {
+    portENTER_CRITICAL(&display_mailbox_lock);
+    uint32_t full = display_mailbox_full;
+    for (int type = 0; type < DISPLAY_EVENT_COUNT; type++) {
+        if (full & (1u << type)) {
+            mail[type] = display_mailbox[type];
+        }
+    }
+    display_mailbox_full = 0;
+    portEXIT_CRITICAL(&display_mailbox_lock);
+    return full;
+}
+
+// Limit rendering to fps frames per second
+void oled_set_max_fps(int fps) {
+    if (fps <= 0) return;
+    frame_ticks = pdMS_TO_TICKS(1000 / fps);
+}
+
+// Charge the bus traffic since the last sample to state.
+// The flush task transmits after ssd1306_show_buffer returns, so a frame drawn
+// right before a state change can be charged to the new state.
+// Reading the driver counters waits for a flush in progress, so only the display task samples.
+static void display_sample_bus(ui_state_t state) {
+    if (display_dev == NULL || state >= UI_STATE_COUNT) {
+        return;
+    }
+    ssd1306_bus_stats_t now;
+    ssd1306_get_bus_stats(display_dev, &now);
+
+    portENTER_CRITICAL(&display_stats_lock);
+    if (now.transactions >= bus_sampled.transactions) {
+        ssd1306_bus_stats_t *bus = &display_stats.bus[state];
+        bus->transactions += now.transactions - bus_sampled.transactions;
+        bus->payload_bytes += now.payload_bytes - bus_sampled.payload_bytes;
+        bus->command_bytes += now.command_bytes - bus_sampled.command_bytes;
+        bus->errors += now.errors - bus_sampled.errors;
+        bus->tx_time_us += now.tx_time_us - bus_sampled.tx_time_us;
+        if (now.flushes != bus_sampled.flushes) {
+            bus->flushes += now.flushes - bus_sampled.flushes;
+            bus->last_flush_us = now.last_flush_us;
+            if (now.last_flush_us > bus->max_flush_us) {
+                bus->max_flush_us = now.last_flush_us;
+            }
+        }
+        bus_sampled = now;
+    }
+    portEXIT_CRITICAL(&display_stats_lock);
+}
+
+// Counters as of the last frame of the display task. Never waits for the bus.
+void oled_get_display_stats(display_stats_t *stats) {
+    portENTER_CRITICAL(&display_stats_lock);
+    *stats = display_stats;
+    portEXIT_CRITICAL(&display_stats_lock);
+}
+
+// Log the frame counters, the driver bus totals and the bus usage of each UI state shown so far.
+// Reading the driver totals waits for a flush in progress.
+void oled_log_display_stats(void) {
+    static display_stats_t stats;  // Too large for the stack of the calling tasks
+    oled_get_display_stats(&stats);
+    ESP_LOGI(TAG, "display: %lu frames, %lu coalesced, %lu dropped events",
+             (unsigned long)stats.frames, (unsigned long)stats.coalesced, (unsigned long)stats.dropped);
+    if (display_dev == NULL) {
+        return;
+    }
+    // Constant once every screen was shown, the display path only allocates on first use
+    ESP_LOGI(TAG, "display: %lu heap allocations", (unsigned long)ssd1306_get_allocs(display_dev));
+    ssd1306_log_bus_stats(display_dev, "bus total", NULL);
+    for (int state = 0; state < UI_STATE_COUNT; state++) {
+        if (stats.bus[state].transactions == 0) {
+            continue;
+        }
+        ssd1306_log_bus_stats(display_dev, ui_state_names[state], &stats.bus[state]);
     }
-    return false;
 }
 
-// Task responsible for handling display updates
+// Count a frame of the display task and charge its bus traffic to state
+static void display_frame_done(uint32_t coalesced, ui_state_t state) {
+    portENTER_CRITICAL(&display_stats_lock);
+    display_stats.frames++;
+    display_stats.coalesced += coalesced;
+    portEXIT_CRITICAL(&display_stats_lock);
+    display_sample_bus(state);
+}
+
+// Task responsible for handling display updates.
+// Events posted within one frame period are coalesced: only the newest light status
+// and the newest event overall are drawn, which gives the same screen as drawing each in turn.
+// While ui_set_state() shows a contextual screen, that screen owns the panel and is rendered
+// every frame until it times out; events wait in their mailboxes and the event screen is
+// drawn again afterwards.
+// Switching between the event screen and a contextual screen slides the new screen in. The
+// frames of a slide are shown from this loop between waits, so the task never blocks on it;
+// a screen change during a slide ends it at once.
 static void display_task(void *pvParameter) {
     SSD1306_t *dev = (SSD1306_t *)pvParameter;
-    display_event_t event;
+    static display_mailbox_t mail[DISPLAY_EVENT_COUNT];
+    TickType_t last_frame = xTaskGetTickCount() - frame_ticks;
+    // Newest event and light status drawn, kept to redraw the event screen.
+    // Until the first event the middle zone stays empty, as for a light status.
+    display_event_t last = { .event_type = DISPLAY_UPDATE_LIGHT_STATUS };
+    display_event_t light;
+    bool has_light = false;
+    bool contextual = false;  // A contextual screen was rendered by the previous frame
+    TickType_t anim_wait = 0;  // Ticks until the next frame of the running slide, 0 for none
+    ui_state_t anim_state = UI_STATE_MAIN;  // State the running slide leads to
 
     while (1) {
-        // Wait for a message in the display queue
-        if (xQueueReceive(display_queue, &event, portMAX_DELAY) == pdTRUE) {
-            // Clear the middle screen (Pages 2-5)
-            for (int i = ZONE_4_START_PAGE; i <= ZONE_4_END_PAGE; i++) {
-                ssd1306_clear_line(dev, i, false);
+        // Wait for a post, or for the next frame of a slide or of a contextual screen
+        TickType_t wait = portMAX_DELAY;
+        if (anim_wait != 0) {
+            wait = anim_wait;
+        } else if (contextual) {
+            wait = frame_ticks;
+        }
+        ulTaskNotifyTake(pdTRUE, wait);
+
+        ui_context_t ctx;
+        ui_get_context(&ctx);
+        ui_return_to_main_if_expired(&ctx);
+        if (anim_wait != 0) {
+            if (ctx.current_state == anim_state) {
+                // Posts for the screen being slid in keep in their mailboxes until the slide ends,
+                // then its last frame falls through to draw them
+                anim_wait = ssd1306_anim_step(dev);
+                if (anim_wait != 0) {
+                    continue;
+                }
+            } else {
+                ssd1306_anim_finish(dev);
+                anim_wait = 0;
+            }
+        }
+
+        // Hold the frame until the frame period has passed; newer posts overwrite their mailbox meanwhile
+        TickType_t elapsed = xTaskGetTickCount() - last_frame;
+        if (elapsed < frame_ticks) {
+            vTaskDelay(frame_ticks - elapsed);
+        }
+
+        if (ctx.current_state != UI_STATE_MAIN) {
+            // Only the widgets whose context changed are redrawn, an idle frame sends nothing
+            contextual = true;
+            if (ctx.current_state != ui_shown_state()) {
+                // Close the bus accounting of the screen being left
+                display_sample_bus(ui_shown_state());
+                ssd1306_anim_begin(dev);
+                ui_draw(dev, ctx.current_state);
+                anim_wait = ssd1306_anim_start(dev, ANIM_SLIDE_LEFT, DISPLAY_TRANSITION_MS);
+                anim_state = ctx.current_state;
+            } else if (!ui_render(dev, ctx.current_state)) {
+                continue;
+            }
+            last_frame = xTaskGetTickCount();
+            display_frame_done(0, ctx.current_state);
+            continue;
+        }
+
+        uint32_t full = display_take_mail(mail);
+        bool redraw = contextual;
+        contextual = false;
+        if (full == 0 && !redraw) {
+            continue;  // Taken by the previous frame already
+        }
+        if (redraw) {
+            // Back from a contextual screen, the event screen is drawn from scratch and slid in
+            ssd1306_anim_begin(dev);
+            _ssd1306_clear_screen(dev, false);
+        }
+
+        // The middle zone shows the newest event of any type
+        int newest = -1;
+        uint32_t coalesced = 0;
+        for (int type = 0; type < DISPLAY_EVENT_COUNT; type++) {
+            if (!(full & (1u << type))) {
+                continue;
             }
+            if (newest < 0) {
+                newest = type;
+            } else {
+                coalesced++;
+                if ((int32_t)(mail[type].seq - mail[newest].seq) > 0) {
+                    newest = type;
+                }
+            }
+        }
+        bool new_light = (full & (1u << DISPLAY_UPDATE_LIGHT_STATUS)) != 0;
+        if (new_light) {
+            light = mail[DISPLAY_UPDATE_LIGHT_STATUS].event;
+            has_light = true;
+        }
+        if (newest >= 0) {
+            last = mail[newest].event;
+        }
+
+        // Clear the middle screen (Pages 2-5)
+        for (int i = ZONE_4_START_PAGE; i <= ZONE_4_END_PAGE; i++) {
+            _ssd1306_clear_line(dev, i, false);
+        }
 
-            // Handle different display events
-            switch (event.event_type) {
-                case DISPLAY_UPDATE_CLOCK:
-                    display_time_x3(dev, event.display_text);
-                    break;
+        if (has_light && (new_light || redraw)) {
+            _ssd1306_display_text(dev, 0, light.display_text, strlen(light.display_text), false);
+        }
 
-                case DISPLAY_UPDATE_LIGHT_STATUS:
-                    ssd1306_display_text(dev, 0, event.display_text, strlen(event.display_text), false);
-                    break;
+        // Handle different display events
+        switch (last.event_type) {
+            case DISPLAY_UPDATE_CLOCK:
+                draw_time_x3(dev, last.display_text);
+                break;
 
-                case DISPLAY_UPDATE_HEIGHT:
-                    ssd1306_display_text(dev, ZONE_4_START_PAGE, event.display_text, strlen(event.display_text), false);
-                    break;
+            case DISPLAY_UPDATE_LIGHT_STATUS:
+                break;
 
-                case DISPLAY_UPDATE_POMODORO:
-                    ssd1306_display_text(dev, ZONE_4_START_PAGE, event.display_text, strlen(event.display_text), false);
-                    break;
+            case DISPLAY_UPDATE_HEIGHT:
+                _ssd1306_display_text(dev, ZONE_4_START_PAGE, last.display_text, strlen(last.display_text), false);
+                break;
 
-                case DISPLAY_UPDATE_SKYLIGHT:
-                    ssd1306_display_text(dev, ZONE_4_START_PAGE, event.display_text, strlen(event.display_text), false);
-                    break;
+            case DISPLAY_UPDATE_POMODORO:
+                _ssd1306_display_text(dev, ZONE_4_START_PAGE, last.display_text, strlen(last.display_text), false);
+                break;
 
-                default:
-                    ESP_LOGE(TAG, "Unhandled display event type: %d", event.event_type);
-                    break;
-            }
+            case DISPLAY_UPDATE_SKYLIGHT:
+                _ssd1306_display_text(dev, ZONE_4_START_PAGE, last.display_text, strlen(last.display_text), false);
+                break;
 
+            default:
+                ESP_LOGE(TAG, "Unhandled display event type: %d", last.event_type);
+                break;
+        }
 
+        if (redraw) {
+            anim_wait = ssd1306_anim_start(dev, ANIM_SLIDE_RIGHT, DISPLAY_TRANSITION_MS);
+            anim_state = UI_STATE_MAIN;
+        } else {
             ssd1306_show_buffer(dev);  // Refresh the OLED display
         }
+        ui_invalidate();  // Drawn over the contextual UI
+        last_frame = xTaskGetTickCount();
+        display_frame_done(coalesced, UI_STATE_MAIN);
+
+        if (DISPLAY_STATS_LOG_MS > 0 && last_frame - stats_logged >= pdMS_TO_TICKS(DISPLAY_STATS_LOG_MS)) {
+            stats_logged = last_frame;
+            oled_log_display_stats();
+        }
     }
 }
 
-// I2C Initialization
-void i2c_master_init_custom(SSD1306_t *dev, int16_t sda, int16_t scl, int16_t reset) {
-    i2c_config_t i2c_config = {
-        .mode = I2C_MODE_MASTER,
-        .sda_io_num = sda,
-        .scl_io_num = scl,
-        .sda_pullup_en = GPIO_PULLUP_ENABLE,
-        .scl_pullup_en = GPIO_PULLUP_ENABLE,
-        .master.clk_speed = 1000000  // 1 MHz
-    };
-    i2c_param_config(dev->_i2c_num, &i2c_config);
-    i2c_driver_install(dev->_i2c_num, I2C_MODE_MASTER, 0, 0, 0);
+// I2C Initialization. The bus belongs to the i2c_manager so sensors can share it;
+// the panel is its lowest priority device and its frames go out a page at a time.
+void i2c_master_init_custom(SSD1306_t *dev, int16_t sda, int16_t scl, int16_t reset, uint32_t clk_hz) {
+    ESP_ERROR_CHECK(i2c_manager_init(dev->_i2c_num, sda, scl, clk_hz));
+    ESP_ERROR_CHECK(i2c_manager_add_device(OLED_I2C_ADDRESS, 0, I2C_PRIORITY_LOW, &oled_i2c));
+    i2c_shared_add(dev, dev->_i2c_num, oled_i2c_write, oled_i2c, -1);
+    dev->_address = OLED_I2C_ADDRESS;
 
     if (reset != -1) {
         gpio_set_direction(reset, GPIO_MODE_OUTPUT);
@@ -186,20 +424,30 @@ void i2c_master_init_custom(SSD1306_t *dev, int16_t sda, int16_t scl, int16_t re
     ESP_LOGI(TAG, "I2C initialized successfully");
 }
 
-// Display clock in large font (Pages 2-5)
-void display_time_x3(SSD1306_t *dev, const char *time) {
-    int len = strlen(time);
-    int total_width = len * CHAR_WIDTH_3X;
-    int seg_offset = (SCREEN_WIDTH - total_width) / 2;  // Center the text
+// Draw text in the 3x font centered on the screen, clipped at the right edge if too long
+static void display_text_x3_centered(SSD1306_t *dev, int page, const char *text) {
+    int len = strlen(text);
+    int seg_offset = (SCREEN_WIDTH - len * CHAR_WIDTH_3X) / 2;
+    if (seg_offset < 0) seg_offset = 0;
+    _ssd1306_display_text_scaled(dev, page, seg_offset, (char *)text, len, 3, false);
+}
 
+// Draw the clock in large font (Pages 2-5) into the buffer only
+static void draw_time_x3(SSD1306_t *dev, const char *time) {
     // Clear the zone first
     for (int i = ZONE_4_START_PAGE; i <= ZONE_4_END_PAGE; i++) {
-        ssd1306_clear_line(dev, i, false);
+        _ssd1306_clear_line(dev, i, false);
     }
 
     // Display large time text on Pages 2-5
-    ssd1306_display_text_x3(dev, ZONE_4_START_PAGE, (char *)time, len, false);
+    display_text_x3_centered(dev, ZONE_4_START_PAGE, time);
+}
+
+// Display clock in large font (Pages 2-5)
+void display_time_x3(SSD1306_t *dev, const char *time) {
+    draw_time_x3(dev, time);
     ssd1306_show_buffer(dev);  // Refresh the display
+    ui_invalidate();  // Drawn over the contextual UI
 }
 void time_update_task(void *pvParameter) {
     SSD1306_t *dev = (SSD1306_t *)pvParameter;
@@ -218,337 +466,18 @@ void time_update_task(void *pvParameter) {
         // Format time as "HH:MM"
         strftime(time_str, sizeof(time_str), "%H:%M", &timeinfo);
 
-        // Send the clock update event to the queue
+        // Post the clock update to the display task
         snprintf(event.display_text, sizeof(event.display_text), "%s", time_str);
-        oled_send_display_event(&event);  // Send clock update to the display queue
+        oled_send_display_event(&event);
 
         // Wait for 1 minute before updating again
         vTaskDelay(pdMS_TO_TICKS(60000));  // Delay for 60 seconds
     }
 }
-// Function to draw a bitmap of specified width and height at a given position
-void ssd1306_draw_bitmap_16x16(SSD1306_t *dev, int x, int y, const uint16_t *bitmap) {
-    // Iterate over each of the 16 columns
-    for (int col = 0; col < 16; col++) {
-        uint16_t column_data = bitmap[col];  // Get the column's data
-
-        // Iterate over each bit in the column
-        for (int bit = 0; bit < 16; bit++) {
-            int ypos = y + bit;  // Calculate the y position
-
-            // Extract the pixel value (1 or 0) for the current bit
-            bool is_on = (column_data >> bit) & 0x01;
-
-            // Draw the pixel at (x + col, ypos)
-            _ssd1306_pixel(dev, x + col, ypos, !is_on);  // Assuming your display logic is inverted
-        }
-    }
-
-    // Refresh the display to show the changes
-    ssd1306_show_buffer(dev);
-}
-
-
 void display_bluetooth_icon(SSD1306_t *dev) {
     int xpos = 72;  // Center the icon horizontally (128 - 16) / 2
-    int page = 16;   // Starting vertical position (page 3)
-    ssd1306_draw_bitmap_16x16(dev, xpos, page, bluetooth);
-}
-
-// ============================================================================
-// NEW CONTEXTUAL UI SYSTEM
-// ============================================================================
-
-// UI State Management Functions
-void ui_set_state(ui_state_t state, uint32_t duration_ms) {
-    ui_ctx.current_state = state;
-    ui_ctx.state_start_time = xTaskGetTickCount() * portTICK_PERIOD_MS;
-    ui_ctx.display_duration_ms = duration_ms;
-}
-
-bool ui_should_return_to_main(void) {
-    if (ui_ctx.current_state == UI_STATE_MAIN) {
-        return false;
-    }
-
-    uint32_t current_time = xTaskGetTickCount() * portTICK_PERIOD_MS;
-    return (current_time - ui_ctx.state_start_time) >= ui_ctx.display_duration_ms;
-}
-
-// Context setters
-void ui_set_wifi_status(const char* status, const char* ip) {
-    strncpy(ui_ctx.context.wifi_status, status, sizeof(ui_ctx.context.wifi_status) - 1);
-    strncpy(ui_ctx.context.ip_address, ip, sizeof(ui_ctx.context.ip_address) - 1);
-}
-
-void ui_set_desk_context(float height, bool moving, bool moving_up) {
-    ui_ctx.context.desk_height = height;
-    ui_ctx.context.desk_moving = moving;
-    ui_ctx.context.desk_moving_up = moving_up;
-}
-
-void ui_set_volume_context(int volume_percent) {
-    ui_ctx.context.volume_level = volume_percent;
-}
-
-void ui_set_hue_context(const char* scene, int brightness) {
-    strncpy(ui_ctx.context.hue_scene, scene, sizeof(ui_ctx.context.hue_scene) - 1);
-    ui_ctx.context.hue_brightness = brightness;
-}
-
-void ui_set_pc_context(int pc_number) {
-    ui_ctx.context.pc_number = pc_number;
-}
-
-void ui_set_window_context(bool opening, bool closing, bool ack) {
-    ui_ctx.context.window_opening = opening;
-    ui_ctx.context.window_closing = closing;
-    ui_ctx.context.http_ack_received = ack;
-}
-
-void ui_set_fan_context(int fan_percent, bool active) {
-    ui_ctx.context.fan_speed_percent = fan_percent;
-    ui_ctx.context.fan_active = active;
-}
-
-// UI Display Functions
-void ui_show_main(SSD1306_t *dev) {
-    // Clear the entire screen first
-    ssd1306_clear_screen(dev, false);
-    ssd1306_clear_line(dev, 0, false);
-    ssd1306_clear_line(dev, 1, false);
-    ssd1306_clear_line(dev, 2, false);
-    ssd1306_clear_line(dev, 3, false);
-    ssd1306_clear_line(dev, 4, false);
-    ssd1306_clear_line(dev, 5, false);
-    ssd1306_clear_line(dev, 6, false);
-    ssd1306_clear_line(dev, 7, false);
-
-    // Top line: WiFi status (moved right)
-    char wifi_line[32];
-    snprintf(wifi_line, sizeof(wifi_line), "WiFi: Connected");
-    ssd1306_display_text(dev, 0, wifi_line, strlen(wifi_line), false);
-
-    // Get current time
-    time_t now;
-    struct tm timeinfo;
-    time(&now);
-    localtime_r(&now, &timeinfo);
-
-    // Large time display (center, moved right)
-    char time_str[16];
-    strftime(time_str, sizeof(time_str), "%H:%M:%S", &timeinfo);
-    ssd1306_display_text_x3(dev, 2, time_str, strlen(time_str), false);
-
-    // Date display (bottom, moved right)
-    char date_str[32];
-    strftime(date_str, sizeof(date_str), "%a %d/%m", &timeinfo);
-    ssd1306_display_text(dev, 6, date_str, strlen(date_str), false);
-
-    ssd1306_show_buffer(dev);
-}
-
-void ui_show_desk(SSD1306_t *dev, float height, bool moving, bool moving_up) {
-    ssd1306_clear_screen(dev, false);
-
-    // Title
-    if (moving) {
-        ssd1306_display_text(dev, 0, moving_up ? "DESK MOVING UP" : "DESK MOVING DOWN",
-                           moving_up ? 13 : 15, false);
-    } else {
-        ssd1306_display_text(dev, 0, "DESK HEIGHT", 11, false);
-    }
-
-    // Height display
-    char height_str[32];
-    snprintf(height_str, sizeof(height_str), "Height: %.1fcm", height);
-    ssd1306_display_text(dev, 2, height_str, strlen(height_str), false);
-
-    // Progress bar (if moving)
-    if (moving) {
-        // Simple progress bar based on height (assuming 60-80cm range)
-        int progress = (int)((height - 60.0) / 20.0 * 10); // 0-10 scale
-        char bar[16] = "          ";
-        for (int i = 0; i < progress && i < 10; i++) {
-            bar[i] = 0xFF; // Full block character
-        }
-        ssd1306_display_text(dev, 5, bar, 10, false);
-    }
-
-    ssd1306_show_buffer(dev);
-}
-
-void ui_show_volume(SSD1306_t *dev, int volume_percent) {
-    // Clear the entire screen properly
-    ssd1306_clear_screen(dev, false);
-    for (int i = 0; i < 8; i++) {
-        ssd1306_clear_line(dev, i, false);
-    }
-
-    // Title (moved right)
-    ssd1306_display_text(dev, 0, "    VOLUME", 10, false);
-
-    // Volume percentage (moved right)
-    char vol_str[16];
-    snprintf(vol_str, sizeof(vol_str), "    %d%%", volume_percent);
-    ssd1306_display_text_x3(dev, 2, vol_str, strlen(vol_str), false);
-
-    // Volume bar (moved right)
-    char bar[20] = "    ";
-    int filled = volume_percent / 10; // 0-10 scale
-    for (int i = 0; i < filled && i < 10; i++) {
-        bar[i + 4] = '='; // Use = instead of 0xFF
-    }
-    for (int i = filled; i < 10; i++) {
-        bar[i + 4] = '-'; // Empty part
-    }
-    bar[14] = '\0'; // Null terminate
-    ssd1306_display_text(dev, 6, bar, strlen(bar), false);
-
+    int ypos = 16;  // Page aligned, so the atlas entry is copied page by page
+    _ssd1306_draw_icon(dev, &icon_atlas[ICON_BLUETOOTH_STATUS], xpos, ypos, false);
     ssd1306_show_buffer(dev);
+    ui_invalidate();  // Drawn over the contextual UI
 }
-
-void ui_show_hue(SSD1306_t *dev, const char* scene, int brightness) {
-    ssd1306_clear_screen(dev, false);
-
-    // Title
-    ssd1306_display_text(dev, 0, "HUE LIGHTS", 10, false);
-
-    // Scene name
-    char scene_str[32];
-    snprintf(scene_str, sizeof(scene_str), "Scene: %s", scene);
-    ssd1306_display_text(dev, 2, scene_str, strlen(scene_str), false);
-
-    // Brightness bar
-    char bright_str[16];
-    snprintf(bright_str, sizeof(bright_str), "Bright: %d%%", brightness);
-    ssd1306_display_text(dev, 4, bright_str, strlen(bright_str), false);
-
-    // Brightness bar
-    char bar[16] = "          ";
-    int filled = brightness / 10; // 0-10 scale
-    for (int i = 0; i < filled && i < 10; i++) {
-        bar[i] = 0xFF; // Full block
-    }
-    ssd1306_display_text(dev, 5, bar, 10, false);
-
-    ssd1306_show_buffer(dev);
-}
-
-void ui_show_pc_switch(SSD1306_t *dev, int pc_number) {
-    ssd1306_clear_screen(dev, false);
-
-    // Title
-    ssd1306_display_text(dev, 0, "USB SWITCH", 10, false);
-
-    // Switching message
-    ssd1306_display_text(dev, 2, "Switching to", 12, false);
-
-    // PC number (large)
-    char pc_str[16];
-    snprintf(pc_str, sizeof(pc_str), "PC %d", pc_number);
-    ssd1306_display_text_x3(dev, 4, pc_str, strlen(pc_str), false);
-
-    ssd1306_show_buffer(dev);
-}
-
-void ui_show_window(SSD1306_t *dev, bool opening, bool closing, bool ack) {
-    ssd1306_clear_screen(dev, false);
-
-    // Title
-    ssd1306_display_text(dev, 0, "WINDOW CONTROL", 14, false);
-
-    // Action
-    if (opening) {
-        ssd1306_display_text(dev, 2, "OPENING", 7, false);
-    } else if (closing) {
-        ssd1306_display_text(dev, 2, "CLOSING", 7, false);
-    }
-
-    // Acknowledgment
-    if (ack) {
-        ssd1306_display_text(dev, 6, "Command Sent OK", 15, false);
-    } else {
-        ssd1306_display_text(dev, 6, "Sending...", 10, false);
-    }
-
-    ssd1306_show_buffer(dev);
-}
-
-void ui_show_fan(SSD1306_t *dev, int fan_percent, bool active) {
-    // Clear the entire screen properly
-    ssd1306_clear_screen(dev, false);
-    for (int i = 0; i < 8; i++) {
-        ssd1306_clear_line(dev, i, false);
-    }
-
-    // Title (moved right)
-    ssd1306_display_text(dev, 0, "    FAN SPEED", 13, false);
-
-    // Fan status
-    if (active) {
-        // Fan percentage (moved right)
-        char fan_str[16];
-        snprintf(fan_str, sizeof(fan_str), "    %d%%", fan_percent);
-        ssd1306_display_text_x3(dev, 2, fan_str, strlen(fan_str), false);
-
-        // Fan speed bar (moved right)
-        char bar[20] = "    ";
-        int filled = fan_percent / 10; // 0-10 scale
-        for (int i = 0; i < filled && i < 10; i++) {
-            bar[i + 4] = '='; // Use = for filled
-        }
-        for (int i = filled; i < 10; i++) {
-            bar[i + 4] = '-'; // Empty part
-        }
-        bar[14] = '\0'; // Null terminate
-        ssd1306_display_text(dev, 6, bar, strlen(bar), false);
-    } else {
-        // Fan off message
-        ssd1306_display_text_x3(dev, 2, "   OFF", 6, false);
-        ssd1306_display_text(dev, 6, "    Fan Stopped", 15, false);
-    }
-
-    ssd1306_show_buffer(dev);
-}
-
-// Main UI update function - call this regularly to update display
-void ui_update_display(SSD1306_t *dev) {
-    // Check if we should return to main screen
-    if (ui_should_return_to_main()) {
-        ui_ctx.current_state = UI_STATE_MAIN;
-    }
-
-    // Display based on current state
-    switch (ui_ctx.current_state) {
-        case UI_STATE_MAIN:
-            ui_show_main(dev);
-            break;
-
-        case UI_STATE_DESK:
-            ui_show_desk(dev, ui_ctx.context.desk_height,
-                        ui_ctx.context.desk_moving, ui_ctx.context.desk_moving_up);
-            break;
-
-        case UI_STATE_VOLUME:
-            ui_show_volume(dev, ui_ctx.context.volume_level);
-            break;
-
-        case UI_STATE_HUE:
-            ui_show_hue(dev, ui_ctx.context.hue_scene, ui_ctx.context.hue_brightness);
-            break;
-
-        case UI_STATE_PC_SWITCH:
-            ui_show_pc_switch(dev, ui_ctx.context.pc_number);
-            break;
-
-        case UI_STATE_WINDOW:
-            ui_show_window(dev, ui_ctx.context.window_opening,
-                          ui_ctx.context.window_closing, ui_ctx.context.http_ack_received);
-            break;
-
-        case UI_STATE_FAN:
-            ui_show_fan(dev, ui_ctx.context.fan_speed_percent, ui_ctx.context.fan_active);
-            break;
-    }
-}
\ No newline at end of file
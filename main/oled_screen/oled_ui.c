@@ -0,0 +1,424 @@
+#include "oled_ui.h"
+#include <stdio.h>
+#include <string.h>
+#include "oled_widgets.h"
+
+// Contextual UI: one screen per ui_state_t, drawn from retained widget layouts.
+// Nothing here touches the bus directly, so the screens also render on the host emulator.
+
+// Global UI context for new contextual display system
+static ui_context_t ui_ctx = {
+    .current_state = UI_STATE_MAIN,
+    .state_start_time = 0,
+    .display_duration_ms = 3000,  // 3 seconds default
+    .context = {
+        .desk_height = 0.0,
+        .desk_moving = false,
+        .desk_moving_up = false,
+        .volume_level = 50,
+        .hue_scene = "Unknown",
+        .hue_brightness = 50,
+        .pc_number = 1,
+        .window_opening = false,
+        .window_closing = false,
+        .http_ack_received = false,
+        .wifi_status = "●●●○",
+        .ip_address = "192.168.x.x",
+        .fan_speed_percent = 0,
+        .fan_active = false
+    }
+};
+
+// Layout of the contextual UI on the panel, UI_STATE_COUNT after anything else drew over it
+static ui_state_t ui_shown_layout = UI_STATE_COUNT;
+
+// Task woken by ui_set_state(), see ui_set_render_task()
+static TaskHandle_t ui_render_task;
+
+// Clock of the main screen
+static time_t (*ui_time)(time_t *) = time;
+
+
+// ui_ctx is written by the setters below from several tasks and read by the renderer.
+// It is guarded by a sequence lock: writers serialize on ui_ctx_lock for the few stores of
+// their change and keep ui_ctx_seq odd meanwhile. The renderer copies the context without
+// taking any lock and copies again when the sequence was odd or moved, so it always renders
+// a consistent snapshot, strings included.
+static portMUX_TYPE ui_ctx_lock = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t ui_ctx_seq;
+
+static void ui_ctx_write_begin(void) {
+    portENTER_CRITICAL(&ui_ctx_lock);
+    __atomic_store_n(&ui_ctx_seq, ui_ctx_seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+static void ui_ctx_write_end(void) {
+    __atomic_store_n(&ui_ctx_seq, ui_ctx_seq + 1, __ATOMIC_RELEASE);
+    portEXIT_CRITICAL(&ui_ctx_lock);
+}
+
+void ui_get_context(ui_context_t *ctx) {
+    uint32_t seq;
+    do {
+        seq = __atomic_load_n(&ui_ctx_seq, __ATOMIC_ACQUIRE);
+        memcpy(ctx, &ui_ctx, sizeof(ui_context_t));
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    } while ((seq & 1) || seq != __atomic_load_n(&ui_ctx_seq, __ATOMIC_RELAXED));
+}
+
+// Copy a string into a context field, always terminated
+static void ui_ctx_copy_str(char *dst, const char *src, size_t len) {
+    strncpy(dst, src, len - 1);
+    dst[len - 1] = '\0';
+}
+
+// UI State Management Functions
+// Shows state for duration_ms on the panel; the display task renders it and never blocks the caller.
+void ui_set_state(ui_state_t state, uint32_t duration_ms) {
+    ui_ctx_write_begin();
+    ui_ctx.current_state = state;
+    ui_ctx.state_start_time = xTaskGetTickCount() * portTICK_PERIOD_MS;
+    ui_ctx.display_duration_ms = duration_ms;
+    ui_ctx_write_end();
+    if (ui_render_task != NULL) {
+        xTaskNotifyGive(ui_render_task);
+    }
+}
+
+// Task to wake when a state is set, the display task of the application
+void ui_set_render_task(TaskHandle_t task) {
+    ui_render_task = task;
+}
+
+static bool ui_context_expired(const ui_context_t *ctx) {
+    if (ctx->current_state == UI_STATE_MAIN) {
+        return false;
+    }
+
+    uint32_t current_time = xTaskGetTickCount() * portTICK_PERIOD_MS;
+    return (current_time - ctx->state_start_time) >= ctx->display_duration_ms;
+}
+
+bool ui_should_return_to_main(void) {
+    ui_context_t ctx;
+    ui_get_context(&ctx);
+    return ui_context_expired(&ctx);
+}
+
+// Context setters
+void ui_set_wifi_status(const char* status, const char* ip) {
+    ui_ctx_write_begin();
+    ui_ctx_copy_str(ui_ctx.context.wifi_status, status, sizeof(ui_ctx.context.wifi_status));
+    ui_ctx_copy_str(ui_ctx.context.ip_address, ip, sizeof(ui_ctx.context.ip_address));
+    ui_ctx_write_end();
+}
+
+void ui_set_desk_context(float height, bool moving, bool moving_up) {
+    ui_ctx_write_begin();
+    ui_ctx.context.desk_height = height;
+    ui_ctx.context.desk_moving = moving;
+    ui_ctx.context.desk_moving_up = moving_up;
+    ui_ctx_write_end();
+}
+
+void ui_set_volume_context(int volume_percent) {
+    ui_ctx_write_begin();
+    ui_ctx.context.volume_level = volume_percent;
+    ui_ctx_write_end();
+}
+
+void ui_set_hue_context(const char* scene, int brightness) {
+    ui_ctx_write_begin();
+    ui_ctx_copy_str(ui_ctx.context.hue_scene, scene, sizeof(ui_ctx.context.hue_scene));
+    ui_ctx.context.hue_brightness = brightness;
+    ui_ctx_write_end();
+}
+
+void ui_set_pc_context(int pc_number) {
+    ui_ctx_write_begin();
+    ui_ctx.context.pc_number = pc_number;
+    ui_ctx_write_end();
+}
+
+void ui_set_window_context(bool opening, bool closing, bool ack) {
+    ui_ctx_write_begin();
+    ui_ctx.context.window_opening = opening;
+    ui_ctx.context.window_closing = closing;
+    ui_ctx.context.http_ack_received = ack;
+    ui_ctx_write_end();
+}
+
+void ui_set_fan_context(int fan_percent, bool active) {
+    ui_ctx_write_begin();
+    ui_ctx.context.fan_speed_percent = fan_percent;
+    ui_ctx.context.fan_active = active;
+    ui_ctx_write_end();
+}
+
+// UI Display Functions
+// Each screen is a layout of widgets bound to a snapshot of ui_ctx. Rendering it redraws only the widgets
+// whose bound value changed; the panel is cleared only when another screen was shown.
+
+// Clock and date text of the main screen, formatted once per second however often it renders
+static struct {
+    time_t at;
+    char time[12];
+    char date[16];
+} ui_clock;
+
+static void ui_clock_update(void) {
+    time_t now;
+    ui_time(&now);
+    if (now == ui_clock.at) {
+        return;
+    }
+    struct tm timeinfo;
+    localtime_r(&now, &timeinfo);
+    strftime(ui_clock.time, sizeof(ui_clock.time), "%H:%M:%S", &timeinfo);
+    strftime(ui_clock.date, sizeof(ui_clock.date), "%a %d/%m", &timeinfo);
+    ui_clock.at = now;
+}
+
+// Replace the clock of the main screen, e.g. with a fixed time in host tests
+void ui_set_time_source(time_t (*source)(time_t *)) {
+    ui_time = source;
+    ui_clock.at = 0;
+}
+
+static void bind_clock(const ui_context_t *ctx, char *text, size_t len) {
+    ui_clock_update();
+    snprintf(text, len, "%s", ui_clock.time);
+}
+
+static void bind_date(const ui_context_t *ctx, char *text, size_t len) {
+    ui_clock_update();
+    snprintf(text, len, "%s", ui_clock.date);
+}
+
+static void bind_desk_title(const ui_context_t *ctx, char *text, size_t len) {
+    if (!ctx->context.desk_moving) {
+        snprintf(text, len, "DESK HEIGHT");
+    } else {
+        snprintf(text, len, ctx->context.desk_moving_up ? "DESK MOVING UP" : "DESK MOVING DOWN");
+    }
+}
+
+static void bind_desk_height(const ui_context_t *ctx, char *text, size_t len) {
+    snprintf(text, len, "Height: %.1fcm", ctx->context.desk_height);
+}
+
+// Position in the 60-80cm range while moving
+static int bind_desk_progress(const ui_context_t *ctx) {
+    if (!ctx->context.desk_moving) {
+        return -1;
+    }
+    int progress = (int)((ctx->context.desk_height - 60.0) * 5);
+    return (progress < 0) ? 0 : progress;
+}
+
+static void bind_volume_text(const ui_context_t *ctx, char *text, size_t len) {
+    snprintf(text, len, "%d%%", ctx->context.volume_level);
+}
+
+static int bind_volume(const ui_context_t *ctx) {
+    return ctx->context.volume_level;
+}
+
+// UTF-8, the Danish scene names need æ, ø and å
+static void bind_hue_scene(const ui_context_t *ctx, char *text, size_t len) {
+    snprintf(text, len, "Scene: %s", ctx->context.hue_scene);
+}
+
+static void bind_hue_brightness_text(const ui_context_t *ctx, char *text, size_t len) {
+    snprintf(text, len, "Bright: %d%%", ctx->context.hue_brightness);
+}
+
+static int bind_hue_brightness(const ui_context_t *ctx) {
+    return ctx->context.hue_brightness;
+}
+
+static void bind_pc(const ui_context_t *ctx, char *text, size_t len) {
+    snprintf(text, len, "PC %d", ctx->context.pc_number);
+}
+
+static void bind_window_action(const ui_context_t *ctx, char *text, size_t len) {
+    if (ctx->context.window_opening) {
+        snprintf(text, len, "OPENING");
+    } else if (ctx->context.window_closing) {
+        snprintf(text, len, "CLOSING");
+    }
+}
+
+static void bind_window_ack(const ui_context_t *ctx, char *text, size_t len) {
+    snprintf(text, len, ctx->context.http_ack_received ? "Command Sent OK" : "Sending...");
+}
+
+static void bind_fan_text(const ui_context_t *ctx, char *text, size_t len) {
+    if (ctx->context.fan_active) {
+        snprintf(text, len, "%d%%", ctx->context.fan_speed_percent);
+    } else {
+        snprintf(text, len, "OFF");
+    }
+}
+
+static void bind_fan_stopped(const ui_context_t *ctx, char *text, size_t len) {
+    if (!ctx->context.fan_active) {
+        snprintf(text, len, "Fan Stopped");
+    }
+}
+
+static int bind_fan_speed(const ui_context_t *ctx) {
+    return ctx->context.fan_active ? ctx->context.fan_speed_percent : -1;
+}
+
+static ui_widget_t main_widgets[] = {
+    UI_STATUS_BAR("WiFi: Connected"),
+    UI_NUMBER(3, 2, bind_clock),  // HH:MM:SS at 2x fills the full width, a tick redraws one digit cell
+    UI_LABEL_BIND(6, 0, bind_date),
+};
+
+static ui_widget_t desk_widgets[] = {
+    UI_LABEL_BIND(0, 0, bind_desk_title),
+    UI_LABEL_BIND(2, 0, bind_desk_height),
+    UI_BAR(5, 0, 80, bind_desk_progress),
+};
+
+static ui_widget_t volume_widgets[] = {
+    UI_LABEL(0, 32, "VOLUME"),
+    UI_NUMBER(2, 3, bind_volume_text),
+    UI_BAR(6, 32, 80, bind_volume),
+};
+
+static ui_widget_t hue_widgets[] = {
+    UI_LABEL(0, 0, "HUE LIGHTS"),
+    UI_LABEL_FONT(2, &font_prop8, bind_hue_scene),  // Scrolls when too long for the panel
+    UI_LABEL_BIND(4, 0, bind_hue_brightness_text),
+    UI_BAR(5, 0, 80, bind_hue_brightness),
+};
+
+static ui_widget_t pc_switch_widgets[] = {
+    UI_LABEL(0, 0, "USB SWITCH"),
+    UI_LABEL(2, 0, "Switching to"),
+    UI_NUMBER(4, 3, bind_pc),
+};
+
+static ui_widget_t window_widgets[] = {
+    UI_LABEL(0, 0, "WINDOW CONTROL"),
+    UI_LABEL_BIND(2, 0, bind_window_action),
+    UI_LABEL_BIND(6, 0, bind_window_ack),
+};
+
+// The speed bar and the stopped message share page 6 and swap together
+static ui_widget_t fan_widgets[] = {
+    UI_LABEL(0, 32, "FAN SPEED"),
+    UI_NUMBER(2, 3, bind_fan_text),
+    UI_LABEL_BIND(6, 32, bind_fan_stopped),
+    UI_BAR(6, 32, 80, bind_fan_speed),
+};
+
+static ui_layout_t ui_layouts[UI_STATE_COUNT] = {
+    [UI_STATE_MAIN] = UI_LAYOUT(main_widgets),
+    [UI_STATE_DESK] = UI_LAYOUT(desk_widgets),
+    [UI_STATE_VOLUME] = UI_LAYOUT(volume_widgets),
+    [UI_STATE_HUE] = UI_LAYOUT(hue_widgets),
+    [UI_STATE_PC_SWITCH] = UI_LAYOUT(pc_switch_widgets),
+    [UI_STATE_WINDOW] = UI_LAYOUT(window_widgets),
+    [UI_STATE_FAN] = UI_LAYOUT(fan_widgets),
+};
+
+// Render the layout of state into the framebuffer only, starting from its template when it
+// is not the one shown. Returns true when anything was drawn and the buffer needs showing.
+bool ui_draw(SSD1306_t *dev, ui_state_t state) {
+    if (state >= UI_STATE_COUNT) {
+        return false;
+    }
+    ui_layout_t *layout = &ui_layouts[state];
+    if (state != ui_shown_layout) {
+        ui_layout_enter(dev, layout);
+        ui_shown_layout = state;
+    }
+    ui_context_t ctx;
+    ui_get_context(&ctx);
+    return ui_layout_render(dev, layout, &ctx);
+}
+
+// Render the layout of state and show it.
+// Returns true when anything was drawn and shown.
+bool ui_render(SSD1306_t *dev, ui_state_t state) {
+    if (!ui_draw(dev, state)) {
+        return false;
+    }
+    ssd1306_show_buffer(dev);
+    return true;
+}
+
+void ui_show_main(SSD1306_t *dev) {
+    ui_render(dev, UI_STATE_MAIN);
+}
+
+void ui_show_desk(SSD1306_t *dev, float height, bool moving, bool moving_up) {
+    ui_set_desk_context(height, moving, moving_up);
+    ui_render(dev, UI_STATE_DESK);
+}
+
+void ui_show_volume(SSD1306_t *dev, int volume_percent) {
+    ui_set_volume_context(volume_percent);
+    ui_render(dev, UI_STATE_VOLUME);
+}
+
+void ui_show_hue(SSD1306_t *dev, const char* scene, int brightness) {
+    ui_set_hue_context(scene, brightness);
+    ui_render(dev, UI_STATE_HUE);
+}
+
+void ui_show_pc_switch(SSD1306_t *dev, int pc_number) {
+    ui_set_pc_context(pc_number);
+    ui_render(dev, UI_STATE_PC_SWITCH);
+}
+
+void ui_show_window(SSD1306_t *dev, bool opening, bool closing, bool ack) {
+    ui_set_window_context(opening, closing, ack);
+    ui_render(dev, UI_STATE_WINDOW);
+}
+
+void ui_show_fan(SSD1306_t *dev, int fan_percent, bool active) {
+    ui_set_fan_context(fan_percent, active);
+    ui_render(dev, UI_STATE_FAN);
+}
+
+// Layout of the contextual UI on the panel, UI_STATE_COUNT when none is
+ui_state_t ui_shown_state(void) {
+    return ui_shown_layout;
+}
+
+// Something else drew over the panel, the next render starts the layout over
+void ui_invalidate(void) {
+    ui_shown_layout = UI_STATE_COUNT;
+}
+
+// Return to the main screen when the state of the snapshot ctx has timed out, and take a new snapshot
+void ui_return_to_main_if_expired(ui_context_t *ctx) {
+    if (!ui_context_expired(ctx)) {
+        return;
+    }
+    ui_ctx_write_begin();
+    // Unless ui_set_state() started another state since the snapshot
+    if (ui_ctx.state_start_time == ctx->state_start_time) {
+        ui_ctx.current_state = UI_STATE_MAIN;
+    }
+    ui_ctx_write_end();
+    ui_get_context(ctx);
+}
+
+// Main UI update function - call this regularly to update display
+void ui_update_display(SSD1306_t *dev) {
+    ui_context_t ctx;
+    ui_get_context(&ctx);
+
+    // Check if we should return to main screen
+    ui_return_to_main_if_expired(&ctx);
+
+    // Only the widgets of the current state whose context changed are redrawn
+    ui_render(dev, ctx.current_state);
+}
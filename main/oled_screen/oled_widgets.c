@@ -0,0 +1,198 @@
+#include "oled_widgets.h"
+#include <stdio.h>
+#include <string.h>
+#include "esp_heap_caps.h"
+#include "icon_atlas.h"
+
+#define UI_MARQUEE_STEP 2  // Columns a scrolling label moves on each render
+
+static const uint8_t blank[SCREEN_WIDTH];
+
+// Read the binding of w. Returns true when the widget has to be redrawn.
+static bool widget_update(SSD1306_t *dev, ui_widget_t *w, const ui_context_t *ctx) {
+    if (w->type == UI_WIDGET_BAR || w->type == UI_WIDGET_ICON) {
+        int value = w->bind_value ? w->bind_value(ctx) : -1;
+        bool changed = !w->drawn || value != w->value;
+        w->value = value;
+        return changed;
+    }
+
+    char text[UI_WIDGET_TEXT_LEN];
+    if (w->bind_text) {
+        text[0] = '\0';
+        w->bind_text(ctx, text, sizeof(text));
+    } else {
+        snprintf(text, sizeof(text), "%s", w->text ? w->text : "");
+    }
+    bool changed = !w->drawn || strcmp(text, w->shown) != 0;
+    w->cells = 0;
+    if (changed && w->drawn && w->type == UI_WIDGET_NUMBER && strlen(text) == strlen(w->shown)) {
+        // Same length keeps every cell in place, so only the cells that differ are drawn,
+        // e.g. the seconds digit of a clock
+        for (int i = 0; text[i] != '\0' && i < 32; i++) {
+            if (text[i] != w->shown[i]) {
+                w->cells |= 1u << i;
+            }
+        }
+    }
+    if (changed) {
+        strcpy(w->shown, text);
+    }
+    if (w->font != NULL) {
+        if (changed) {
+            ssd1306_marquee_init(dev, &w->marquee, w->font, w->page, w->seg, w->width, w->shown, strlen(w->shown));
+        }
+        // Text wider than the widget scrolls a step on every render
+        if (w->marquee.width > w->marquee.window) {
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+static void widget_clear(SSD1306_t *dev, const ui_widget_t *w) {
+    int pages = w->font ? (w->font->height + 7) / 8 : w->pages;
+    for (int page = w->page; page < w->page + pages; page++) {
+        _ssd1306_display_image(dev, page, w->seg, (uint8_t *)blank, w->width);
+    }
+}
+
+// Outline with the fill inside it, one pixel row apart
+static void widget_draw_bar(SSD1306_t *dev, const ui_widget_t *w) {
+    if (w->value < 0 || w->width < 3) {
+        return;
+    }
+    uint8_t image[SCREEN_WIDTH];
+    int value = (w->value > 100) ? 100 : w->value;
+    int inner = w->width - 2;
+    int filled = inner * value / 100;
+    image[0] = 0x7E;
+    for (int i = 0; i < inner; i++) {
+        image[1 + i] = (i < filled) ? 0x5A : 0x42;
+    }
+    image[w->width - 1] = 0x7E;
+    _ssd1306_display_image(dev, w->page, w->seg, image, w->width);
+}
+
+static void widget_draw(SSD1306_t *dev, ui_widget_t *w) {
+    int len = strlen(w->shown);
+
+    switch (w->type) {
+    case UI_WIDGET_LABEL:
+        if (w->font != NULL) {
+            _ssd1306_marquee_step(dev, &w->marquee, UI_MARQUEE_STEP);
+            break;
+        }
+        if (len > w->width / 8) len = w->width / 8;
+        _ssd1306_display_text_scaled(dev, w->page, w->seg, w->shown, len, 1, false);
+        break;
+
+    case UI_WIDGET_STATUS_BAR: {
+        if (len > w->width / 8) len = w->width / 8;
+        _ssd1306_display_text_scaled(dev, w->page, w->seg, w->shown, len, 1, false);
+        // Rule on the bottom pixel row
+        uint8_t image[SCREEN_WIDTH];
+        memcpy(image, &dev->_page[w->page]._segs[w->seg], w->width);
+        for (int i = 0; i < w->width; i++) {
+            image[i] |= 0x80;
+        }
+        _ssd1306_display_image(dev, w->page, w->seg, image, w->width);
+        break;
+    }
+
+    case UI_WIDGET_NUMBER: {
+        int glyph_width = 8 * w->scale;
+        if (len > w->width / glyph_width) len = w->width / glyph_width;
+        int seg = w->seg + (w->width - len * glyph_width) / 2;
+        if (w->cells == 0) {
+            _ssd1306_display_text_scaled(dev, w->page, seg, w->shown, len, w->scale, false);
+            break;
+        }
+        for (int i = 0; i < len; i++) {
+            if (w->cells & (1u << i)) {
+                _ssd1306_display_text_scaled(dev, w->page, seg + i * glyph_width, &w->shown[i], 1, w->scale, false);
+            }
+        }
+        break;
+    }
+
+    case UI_WIDGET_BAR:
+        widget_draw_bar(dev, w);
+        break;
+
+    case UI_WIDGET_ICON:
+        if (w->value >= 0 && w->value < ICON_COUNT) {
+            _ssd1306_draw_icon(dev, &icon_atlas[w->value], w->seg, w->page * 8, false);
+        }
+        break;
+    }
+}
+
+// Fixed text with no binding: drawn once, into the template of its layout
+static bool widget_is_fixed(const ui_widget_t *w) {
+    return w->bind_text == NULL && w->bind_value == NULL && w->font == NULL;
+}
+
+// Replace the screen with the fixed part of layout; the next render draws the bound widgets.
+// The fixed part is rendered from glyphs once and kept as a template frame. Later entries copy
+// the template into the framebuffer, which only marks the bytes that differ from the screen left.
+void ui_layout_enter(SSD1306_t *dev, ui_layout_t *layout) {
+    if (layout->template != NULL) {
+        ssd1306_set_buffer(dev, (uint8_t *)layout->template);
+    } else {
+        _ssd1306_clear_screen(dev, false);
+        for (int i = 0; i < layout->count; i++) {
+            ui_widget_t *w = &layout->widgets[i];
+            if (widget_is_fixed(w)) {
+                w->drawn = false;
+                widget_update(dev, w, NULL);
+                widget_draw(dev, w);
+            }
+        }
+        // Without memory for it the fixed part is simply rendered again on the next entry
+        layout->template = ssd1306_alloc(dev, SSD1306_FB_LEN, MALLOC_CAP_8BIT);
+        if (layout->template != NULL) {
+            ssd1306_get_buffer(dev, (uint8_t *)layout->template);
+        }
+    }
+    for (int i = 0; i < layout->count; i++) {
+        ui_widget_t *w = &layout->widgets[i];
+        w->drawn = widget_is_fixed(w);
+    }
+}
+
+// Read every binding of layout and redraw the widgets whose value changed, into the
+// framebuffer only. Returns true when anything was drawn and the buffer needs showing.
+bool ui_layout_render(SSD1306_t *dev, ui_layout_t *layout, const ui_context_t *ctx) {
+    bool changed = false;
+
+    // Clear all changed widgets before drawing any, so overlapping ones cannot wipe each other
+    for (int i = 0; i < layout->count; i++) {
+        ui_widget_t *w = &layout->widgets[i];
+        w->pending = widget_update(dev, w, ctx);
+        if (w->pending) {
+            // A glyph covers its whole cell, cells redrawn alone need no clearing
+            if (w->cells == 0) {
+                widget_clear(dev, w);
+            }
+            changed = true;
+        }
+    }
+    for (int i = 0; i < layout->count; i++) {
+        ui_widget_t *w = &layout->widgets[i];
+        if (w->pending) {
+            widget_draw(dev, w);
+            w->drawn = true;
+            w->pending = false;
+        }
+    }
+    return changed;
+}
+
+// Forget what layout put on the panel, e.g. after the screen was cleared.
+// The next render draws every widget.
+void ui_layout_invalidate(ui_layout_t *layout) {
+    for (int i = 0; i < layout->count; i++) {
+        layout->widgets[i].drawn = false;
+    }
+}
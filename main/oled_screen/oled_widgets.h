@@ -0,0 +1,81 @@
+#ifndef OLED_WIDGETS_H
+#define OLED_WIDGETS_H
+
+#include <stdbool.h>
+#include "ssd1306.h"
+#include "oled_ui.h"
+
+// Retained-mode widgets for the contextual UI.
+// A screen is a static array of widgets. Each widget owns a rectangle of the panel and is
+// bound to a value of ui_context_t; ui_layout_render() reads every binding and redraws only
+// the widgets whose value changed since they were drawn. The rest of the framebuffer is left
+// alone, so the flush only carries the columns that changed.
+// Widgets that share panel area (e.g. a bar that gives way to a message) must change together.
+// Switching screens goes through ui_layout_enter(): the fixed labels of a layout are rendered
+// once into a template frame, later entries copy it and only the bound widgets are drawn.
+
+#define UI_WIDGET_TEXT_LEN 48  // Longest bound text, terminator included
+
+typedef enum {
+    UI_WIDGET_LABEL,       // 8x8 text, or a proportional font that scrolls when too wide
+    UI_WIDGET_NUMBER,      // Scaled text centered in the widget, e.g. "75%". Redraws only the
+                           // character cells that changed while the length stays the same
+    UI_WIDGET_BAR,         // Progress bar, value 0-100, negative hides it
+    UI_WIDGET_ICON,        // icon_atlas entry, negative hides it
+    UI_WIDGET_STATUS_BAR,  // Top line of 8x8 text over a rule
+} ui_widget_type_t;
+
+// Bound text: write the text shown for ctx into text
+typedef void (*ui_bind_text_t)(const ui_context_t *ctx, char *text, size_t len);
+// Bound value: the bar percentage or icon shown for ctx
+typedef int (*ui_bind_value_t)(const ui_context_t *ctx);
+
+typedef struct {
+    ui_widget_type_t type;
+    uint8_t page;                 // Top page
+    uint8_t seg;                  // Left column
+    uint8_t width;                // Columns owned, cleared on every redraw
+    uint8_t pages;                // Pages owned, from the font for proportional labels
+    uint8_t scale;                // Text scale of UI_WIDGET_NUMBER
+    const ssd1306_font_t *font;   // Proportional font of a label, NULL for 8x8
+    const char *text;             // Fixed text of a label without binding
+    ui_bind_text_t bind_text;
+    ui_bind_value_t bind_value;
+
+    // Retained state, left zero in the layouts
+    bool drawn;                   // Shown on the panel since the last invalidate
+    bool pending;                 // Changed, redrawn by the current render
+    uint32_t cells;               // Character cells of a UI_WIDGET_NUMBER to redraw, 0 for all
+    int value;
+    char shown[UI_WIDGET_TEXT_LEN];
+    ssd1306_marquee_t marquee;    // Strip of a proportional label
+} ui_widget_t;
+
+typedef struct {
+    ui_widget_t *widgets;
+    int count;
+    uint32_t *template;  // Frame with only the fixed widgets, rendered on the first ui_layout_enter()
+} ui_layout_t;
+
+#define UI_LAYOUT(widgets) { (widgets), sizeof(widgets) / sizeof((widgets)[0]) }
+
+#define UI_LABEL(page_, seg_, text_) \
+    { .type = UI_WIDGET_LABEL, .page = (page_), .seg = (seg_), .width = SCREEN_WIDTH - (seg_), .pages = 1, .text = (text_) }
+#define UI_LABEL_BIND(page_, seg_, bind_) \
+    { .type = UI_WIDGET_LABEL, .page = (page_), .seg = (seg_), .width = SCREEN_WIDTH - (seg_), .pages = 1, .bind_text = (bind_) }
+#define UI_LABEL_FONT(page_, font_, bind_) \
+    { .type = UI_WIDGET_LABEL, .page = (page_), .width = SCREEN_WIDTH, .font = (font_), .bind_text = (bind_) }
+#define UI_NUMBER(page_, scale_, bind_) \
+    { .type = UI_WIDGET_NUMBER, .page = (page_), .width = SCREEN_WIDTH, .pages = (scale_), .scale = (scale_), .bind_text = (bind_) }
+#define UI_BAR(page_, seg_, width_, bind_) \
+    { .type = UI_WIDGET_BAR, .page = (page_), .seg = (seg_), .width = (width_), .pages = 1, .bind_value = (bind_) }
+#define UI_ICON(page_, seg_, width_, pages_, bind_) \
+    { .type = UI_WIDGET_ICON, .page = (page_), .seg = (seg_), .width = (width_), .pages = (pages_), .bind_value = (bind_) }
+#define UI_STATUS_BAR(text_) \
+    { .type = UI_WIDGET_STATUS_BAR, .width = SCREEN_WIDTH, .pages = 1, .text = (text_) }
+
+void ui_layout_enter(SSD1306_t *dev, ui_layout_t *layout);
+bool ui_layout_render(SSD1306_t *dev, ui_layout_t *layout, const ui_context_t *ctx);
+void ui_layout_invalidate(ui_layout_t *layout);
+
+#endif // OLED_WIDGETS_H
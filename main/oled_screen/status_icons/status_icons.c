@@ -0,0 +1,6 @@
+// Status bar icons, one 16 bit column per element with bit 0 at the top.
+// Not compiled: tools/iconconv.py packs these into the icon atlas at build time.
+
+#include <stdint.h>
+
+const uint16_t bluetooth_status_icon16x16[] = {0x0000, 0x0300, 0x0380, 0x02c0, 0x1260, 0x1a60, 0x0ec0, 0x0780, 0x0300, 0x0780, 0x0ec0, 0x1a60, 0x1260, 0x02c0, 0x0380, 0x0300};
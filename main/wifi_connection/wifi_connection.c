@@ -144,18 +144,18 @@ bool wifi_poll_status(SSD1306_t *dev) {
     wifi_ap_record_t ap_info;
     esp_err_t status = esp_wifi_sta_get_ap_info(&ap_info);
 
-    ssd1306_clear_line(dev, 7, false);  // Clear the bottom line (line 7)
+    _ssd1306_clear_line(dev, 7, false);  // Clear the bottom line (line 7)
 
     if (status == ESP_OK) {
         // Wi-Fi connected, print "WiFi: OK" and the RSSI (signal strength)
         char wifi_status[20];
         snprintf(wifi_status, sizeof(wifi_status), "WiFi: OK");
-        ssd1306_display_text(dev, 7, wifi_status, strlen(wifi_status), false);
+        _ssd1306_display_text(dev, 7, wifi_status, strlen(wifi_status), false);
         ssd1306_show_buffer(dev);  // Refresh the OLED display
         return true;
     } else {
         // Wi-Fi not connected, print "No WiFi"
-        ssd1306_display_text(dev, 7, "No WiFi", 7, false);
+        _ssd1306_display_text(dev, 7, "No WiFi", 7, false);
         ssd1306_show_buffer(dev);  // Refresh the OLED display
         return false;
     }